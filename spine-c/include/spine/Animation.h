@@ -75,12 +75,30 @@ void spAnimation_apply (const spAnimation* self, struct spSkeleton* skeleton, fl
 void spAnimation_mix (const spAnimation* self, struct spSkeleton* skeleton, float lastTime, float time, int loop,
 		spEvent** events, int* eventsCount, float alpha);
 
+/** Same as spAnimation_mix, with alpha 1 for spAnimation_apply, but each timeline finds its keyframes starting from its cursor.
+ * When time moves forward by a few frames, as during playback, this avoids a binary search per timeline.
+ * @param cursors May be 0. Otherwise one int per timeline, zeroed before the first call and kept between calls for the same
+ * playback. */
+void spAnimation_mixWithCursors (const spAnimation* self, struct spSkeleton* skeleton, float lastTime, float time, int loop,
+		spEvent** events, int* eventsCount, float alpha, int* cursors);
+
+/** Same as spAnimation_mixWithCursors with alpha 1 for many skeletons, each with its own times. Each timeline is applied to all
+ * the skeletons before the next timeline, so its frames stay in cache when many instances play the same animation.
+ * @param events May be 0. Otherwise one events array per skeleton, triggered events are added to the skeleton's array.
+ * @param eventsCounts One count per skeleton, may be 0 when events is 0.
+ * @param cursors May be 0. Otherwise timelinesCount * count ints, laid out by timeline so the cursors of a timeline are
+ * adjacent: timeline i of skeleton ii uses cursors[i * count + ii]. count must not change between calls. */
+void spAnimation_applyBatch (const spAnimation* self, struct spSkeleton** skeletons, const float* lastTimes, const float* times,
+		int count, int loop, spEvent*** events, int* eventsCounts, int* cursors);
+
 #ifdef SPINE_SHORT_NAMES
 typedef spAnimation Animation;
 #define Animation_create(...) spAnimation_create(__VA_ARGS__)
 #define Animation_dispose(...) spAnimation_dispose(__VA_ARGS__)
 #define Animation_apply(...) spAnimation_apply(__VA_ARGS__)
 #define Animation_mix(...) spAnimation_mix(__VA_ARGS__)
+#define Animation_mixWithCursors(...) spAnimation_mixWithCursors(__VA_ARGS__)
+#define Animation_applyBatch(...) spAnimation_applyBatch(__VA_ARGS__)
 #endif
 
 /**/
@@ -132,12 +150,23 @@ typedef spTimeline Timeline;
 
 typedef struct spCurveTimeline {
 	spTimeline super;
-	float* curves; /* type, x, y, ... */
+	int frameCurvesCount;
+	int* frameCurves; /* Per frame: linear, stepped or the location of the frame's bezier curve in curves. */
+	int curvesCount, curvesCapacity;
+	float* curves; /* Only for bezier frames: segment ends x, y, ... or uniform samples, see lookupError. */
+	/* When > 0, curves set afterward are sampled at uniform intervals so spCurveTimeline_getCurvePercent indexes the samples
+	 * directly instead of searching the curve segments. The number of samples is chosen so the result differs from the segment
+	 * search by at most lookupError, a curve that would need more than 1024 samples keeps its segments. Default is 0. */
+	float lookupError;
 
 #ifdef __cplusplus
 	spCurveTimeline() :
 		super(),
-		curves(0) {
+		frameCurvesCount(0),
+		frameCurves(0),
+		curvesCount(0), curvesCapacity(0),
+		curves(0),
+		lookupError(0) {
 	}
 #endif
 } spCurveTimeline;
@@ -338,12 +367,16 @@ typedef spDrawOrderTimeline DrawOrderTimeline;
 
 /**/
 
+/* Each frame stores only the range of vertices that differ from the setup vertices. */
 typedef struct spFFDTimeline {
 	spCurveTimeline super;
 	int const framesCount;
 	float* const frames; /* time, ... */
 	int const frameVerticesCount;
-	const float** const frameVertices;
+	int* const frameRanges; /* offset, count, start of the frame's vertices in vertices, ... */
+	int verticesCount, verticesCapacity;
+	float* vertices;
+	const float* setupVertices; /* Not owned. 0 when the setup vertices are all 0, as for skinned meshes. */
 	int slotIndex;
 	spAttachment* attachment;
 
@@ -353,20 +386,32 @@ typedef struct spFFDTimeline {
 		framesCount(0),
 		frames(0),
 		frameVerticesCount(0),
-		frameVertices(0),
-		slotIndex(0) {
+		frameRanges(0),
+		verticesCount(0), verticesCapacity(0),
+		vertices(0),
+		setupVertices(0),
+		slotIndex(0),
+		attachment(0) {
 	}
 #endif
 } spFFDTimeline;
 
 spFFDTimeline* spFFDTimeline_create (int framesCount, int frameVerticesCount);
 
-void spFFDTimeline_setFrame (spFFDTimeline* self, int frameIndex, float time, float* vertices);
+/* Stores the range of vertices that differ from setupVertices, which must be set first.
+ * @param vertices May be 0 for the setup vertices. */
+void spFFDTimeline_setFrame (spFFDTimeline* self, int frameIndex, float time, const float* vertices);
+/* @param vertices The count vertices starting at offset, the others are the setup vertices. */
+void spFFDTimeline_setFrameRange (spFFDTimeline* self, int frameIndex, float time, int offset, int count, const float* vertices);
+/* Writes all of the frame's vertices. */
+void spFFDTimeline_getFrameVertices (const spFFDTimeline* self, int frameIndex, float* vertices);
 
 #ifdef SPINE_SHORT_NAMES
 typedef spFFDTimeline FFDTimeline;
 #define FFDTimeline_create(...) spFFDTimeline_create(__VA_ARGS__)
 #define FFDTimeline_setFrame(...) spFFDTimeline_setFrame(__VA_ARGS__)
+#define FFDTimeline_setFrameRange(...) spFFDTimeline_setFrameRange(__VA_ARGS__)
+#define FFDTimeline_getFrameVertices(...) spFFDTimeline_getFrameVertices(__VA_ARGS__)
 #endif
 
 /**/
@@ -430,6 +475,82 @@ typedef spFlipTimeline FlipTimeline;
 
 /**/
 
+/* A rotate, translate, scale, color or IK constraint timeline that stores times as 16 bit ticks and values as 16 bit steps
+ * within a range, decompressing the keys it needs as it is applied. The timeline keeps the type of the timeline it was created
+ * from. */
+typedef struct spCompressedTimeline {
+	spCurveTimeline super;
+	int const framesCount;
+	unsigned short* const times;
+	float const lastFrameTime; /* A tick is 1/65535 of the last frame's time. */
+	int const valuesCount; /* Per frame: 1 for rotate, 2 for translate, scale and IK constraint, 4 for color. */
+	unsigned short* const values;
+	float* const ranges; /* min, max, ... per value. */
+	int index; /* The bone, slot or IK constraint index. */
+
+#ifdef __cplusplus
+	spCompressedTimeline() :
+		super(),
+		framesCount(0),
+		times(0),
+		lastFrameTime(0),
+		valuesCount(0),
+		values(0),
+		ranges(0),
+		index(0) {
+	}
+#endif
+} spCompressedTimeline;
+
+/* Returns 0 if the timeline is not a rotate, translate, scale, color or IK constraint timeline created by this runtime. FFD
+ * timelines are not compressed, their frames already store only the vertices they change.
+ * @param tolerance A key between two linear segments is dropped when interpolating the values around it differs from the
+ * values of every dropped key by at most tolerance, in the units of the timeline's values. Use 0 to only drop keys that are
+ * interpolated exactly. */
+spCompressedTimeline* spCompressedTimeline_create (const spTimeline* timeline, float tolerance);
+
+/* Replaces the animation's rotate, translate, scale, color and IK constraint timelines with compressed timelines. Values
+ * differ from the original by at most tolerance plus 1/65535 of the value's range, and times by half a tick. */
+void spAnimation_compress (spAnimation* self, float tolerance);
+
+#ifdef SPINE_SHORT_NAMES
+typedef spCompressedTimeline CompressedTimeline;
+#define CompressedTimeline_create(...) spCompressedTimeline_create(__VA_ARGS__)
+#define Animation_compress(...) spAnimation_compress(__VA_ARGS__)
+#endif
+
+/**/
+
+/* An animation's timelines grouped by type. Applying runs one loop per type that calls the type's apply directly instead of
+ * dispatching each timeline through its vtable, and timelines with the spBaseTimeline layout are copied next to each other.
+ * Types are applied in spTimelineType order, keeping the order of timelines within a type. The animation must outlive the
+ * compiled animation and its timelines must not be added, removed or changed while it is used. */
+typedef struct spCompiledAnimation {
+	const spAnimation* const animation;
+
+#ifdef __cplusplus
+	spCompiledAnimation() :
+		animation(0) {
+	}
+#endif
+} spCompiledAnimation;
+
+spCompiledAnimation* spCompiledAnimation_create (const spAnimation* animation);
+void spCompiledAnimation_dispose (spCompiledAnimation* self);
+
+/** Same as spAnimation_mixWithCursors for the compiled animation, cursors are indexed the same as the animation's timelines. */
+void spCompiledAnimation_mix (const spCompiledAnimation* self, struct spSkeleton* skeleton, float lastTime, float time, int loop,
+		spEvent** events, int* eventsCount, float alpha, int* cursors);
+
+#ifdef SPINE_SHORT_NAMES
+typedef spCompiledAnimation CompiledAnimation;
+#define CompiledAnimation_create(...) spCompiledAnimation_create(__VA_ARGS__)
+#define CompiledAnimation_dispose(...) spCompiledAnimation_dispose(__VA_ARGS__)
+#define CompiledAnimation_mix(...) spCompiledAnimation_mix(__VA_ARGS__)
+#endif
+
+/**/
+
 #ifdef __cplusplus
 }
 #endif
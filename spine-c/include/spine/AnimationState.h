@@ -85,6 +85,17 @@ struct spAnimationState {
 	int tracksCount;
 	spTrackEntry** tracks;
 
+	/* When true, apply queues the events fired by the tracks' animations instead of calling the listeners with
+	 * SP_ANIMATION_EVENT, see spAnimationState_drainEvents. Start, end and complete are still reported to the listeners. */
+	int/*bool*/deferEvents;
+
+	/* When true, the pose of the animation being mixed out is saved when a mix starts and restored on later frames with
+	 * spSkeleton_restoreAnimationPose instead of applying the animation again, so the outgoing animation holds its pose for
+	 * the rest of the mix. The state must be applied to a single skeleton. Slot attachments and bone flips of the outgoing
+	 * animation are not held: they keep whatever was set last, as when the outgoing animation is applied again at the same
+	 * time, so calling spSkeleton_setToSetupPose before applying reverts them to the setup pose for the rest of the mix. */
+	int/*bool*/freezeMixes;
+
 	void* rendererObject;
 
 #ifdef __cplusplus
@@ -94,17 +105,35 @@ struct spAnimationState {
 		listener(0),
 		tracksCount(0),
 		tracks(0),
+		deferEvents(0),
+		freezeMixes(0),
 		rendererObject(0) {
 	}
 #endif
 };
 
+typedef struct spTrackEvent {
+	int trackIndex;
+	spEvent* event;
+
+#ifdef __cplusplus
+	spTrackEvent() :
+		trackIndex(0),
+		event(0) {
+	}
+#endif
+} spTrackEvent;
+
 /* @param data May be 0 for no mixing. */
 spAnimationState* spAnimationState_create (spAnimationStateData* data);
 void spAnimationState_dispose (spAnimationState* self);
 
 void spAnimationState_update (spAnimationState* self, float delta);
 void spAnimationState_apply (spAnimationState* self, struct spSkeleton* skeleton);
+/** Same as spAnimationState_update followed by spAnimationState_apply, but only the animations' event timelines are
+ * evaluated and no skeleton is needed. Track times advance, queued animations start, mixes finish and the listeners are called
+ * or events queued as for apply, eg to get events and durations on a server that never poses skeletons. */
+void spAnimationState_updateEventsOnly (spAnimationState* self, float delta);
 
 void spAnimationState_clearTracks (spAnimationState* self);
 void spAnimationState_clearTrack (spAnimationState* self, int trackIndex);
@@ -123,6 +152,70 @@ spTrackEntry* spAnimationState_addAnimation (spAnimationState* self, int trackIn
 
 spTrackEntry* spAnimationState_getCurrent (spAnimationState* self, int trackIndex);
 
+/** Moves up to capacity of the events queued while deferEvents was set to events, oldest first, and returns how many were
+ * moved. Events stay queued until drained, so a caller can drain in chunks until fewer than capacity are returned. */
+int spAnimationState_drainEvents (spAnimationState* self, spTrackEvent* events, int capacity);
+
+typedef struct spTrackEntryPoolStats {
+	int created; /* Entries allocated. */
+	int reused; /* Entries taken from the pool instead of allocated. */
+	int pooled; /* Entries in the pool. */
+
+#ifdef __cplusplus
+	spTrackEntryPoolStats() :
+		created(0),
+		reused(0),
+		pooled(0) {
+	}
+#endif
+} spTrackEntryPoolStats;
+
+/** Track entries are kept in a pool owned by the state when they are disposed and reused for the next set or queued
+ * animations. */
+void spAnimationState_getTrackEntryPoolStats (const spAnimationState* self, spTrackEntryPoolStats* stats);
+
+/* The times of a track's current entry and the entry it is mixing from, captured by spAnimationState_saveTimes. */
+typedef struct spTrackTimes {
+	spTrackEntry* entry;
+	spTrackEntry* previous;
+	int entrySerial, previousSerial; /* Pooled entries can reuse the address of a disposed entry. */
+	float time, lastTime, mixTime;
+	float previousTime;
+
+#ifdef __cplusplus
+	spTrackTimes() :
+		entry(0),
+		previous(0),
+		entrySerial(0), previousSerial(0),
+		time(0), lastTime(0), mixTime(0),
+		previousTime(0) {
+	}
+#endif
+} spTrackTimes;
+
+typedef struct spAnimationStateTimes {
+	int const tracksCapacity;
+	int tracksCount;
+	spTrackTimes* const tracks;
+
+#ifdef __cplusplus
+	spAnimationStateTimes() :
+		tracksCapacity(0),
+		tracksCount(0),
+		tracks(0) {
+	}
+#endif
+} spAnimationStateTimes;
+
+spAnimationStateTimes* spAnimationStateTimes_create (int tracksCapacity);
+void spAnimationStateTimes_dispose (spAnimationStateTimes* self);
+
+/* Returns 0 if the state has more tracks than the times can hold. */
+int/*bool*/spAnimationState_saveTimes (const spAnimationState* self, spAnimationStateTimes* times);
+/* Restores the track times, so updating and applying again gives the same results. Returns 0 and restores nothing if the
+ * tracks no longer hold the same entries, eg because an animation was set, queued animations started or a mix finished. */
+int/*bool*/spAnimationState_restoreTimes (spAnimationState* self, const spAnimationStateTimes* times);
+
 #ifdef SPINE_SHORT_NAMES
 typedef spEventType EventType;
 #define ANIMATION_START SP_ANIMATION_START
@@ -132,10 +225,13 @@ typedef spEventType EventType;
 typedef spAnimationStateListener AnimationStateListener;
 typedef spTrackEntry TrackEntry;
 typedef spAnimationState AnimationState;
+typedef spTrackEvent TrackEvent;
+typedef spTrackEntryPoolStats TrackEntryPoolStats;
 #define AnimationState_create(...) spAnimationState_create(__VA_ARGS__)
 #define AnimationState_dispose(...) spAnimationState_dispose(__VA_ARGS__)
 #define AnimationState_update(...) spAnimationState_update(__VA_ARGS__)
 #define AnimationState_apply(...) spAnimationState_apply(__VA_ARGS__)
+#define AnimationState_updateEventsOnly(...) spAnimationState_updateEventsOnly(__VA_ARGS__)
 #define AnimationState_clearTracks(...) spAnimationState_clearTracks(__VA_ARGS__)
 #define AnimationState_clearTrack(...) spAnimationState_clearTrack(__VA_ARGS__)
 #define AnimationState_setAnimationByName(...) spAnimationState_setAnimationByName(__VA_ARGS__)
@@ -143,6 +239,14 @@ typedef spAnimationState AnimationState;
 #define AnimationState_addAnimationByName(...) spAnimationState_addAnimationByName(__VA_ARGS__)
 #define AnimationState_addAnimation(...) spAnimationState_addAnimation(__VA_ARGS__)
 #define AnimationState_getCurrent(...) spAnimationState_getCurrent(__VA_ARGS__)
+#define AnimationState_drainEvents(...) spAnimationState_drainEvents(__VA_ARGS__)
+#define AnimationState_getTrackEntryPoolStats(...) spAnimationState_getTrackEntryPoolStats(__VA_ARGS__)
+typedef spTrackTimes TrackTimes;
+typedef spAnimationStateTimes AnimationStateTimes;
+#define AnimationStateTimes_create(...) spAnimationStateTimes_create(__VA_ARGS__)
+#define AnimationStateTimes_dispose(...) spAnimationStateTimes_dispose(__VA_ARGS__)
+#define AnimationState_saveTimes(...) spAnimationState_saveTimes(__VA_ARGS__)
+#define AnimationState_restoreTimes(...) spAnimationState_restoreTimes(__VA_ARGS__)
 #endif
 
 #ifdef __cplusplus
@@ -58,6 +58,11 @@ void spAnimationStateData_dispose (spAnimationStateData* self);
 
 void spAnimationStateData_setMixByName (spAnimationStateData* self, const char* fromName, const char* toName, float duration);
 void spAnimationStateData_setMix (spAnimationStateData* self, spAnimation* from, spAnimation* to, float duration);
+/* Sets count mix durations at once, eg when loading a mix table, growing the table only once. */
+void spAnimationStateData_setMixesByName (spAnimationStateData* self, const char** fromNames, const char** toNames,
+		const float* durations, int count);
+void spAnimationStateData_setMixes (spAnimationStateData* self, spAnimation** from, spAnimation** to, const float* durations,
+		int count);
 /* Returns 0 if there is no mixing between the animations. */
 float spAnimationStateData_getMix (spAnimationStateData* self, spAnimation* from, spAnimation* to);
 
@@ -67,6 +72,8 @@ typedef spAnimationStateData AnimationStateData;
 #define AnimationStateData_dispose(...) spAnimationStateData_dispose(__VA_ARGS__)
 #define AnimationStateData_setMixByName(...) spAnimationStateData_setMixByName(__VA_ARGS__)
 #define AnimationStateData_setMix(...) spAnimationStateData_setMix(__VA_ARGS__)
+#define AnimationStateData_setMixesByName(...) spAnimationStateData_setMixesByName(__VA_ARGS__)
+#define AnimationStateData_setMixes(...) spAnimationStateData_setMixes(__VA_ARGS__)
 #define AnimationStateData_getMix(...) spAnimationStateData_getMix(__VA_ARGS__)
 #endif
 
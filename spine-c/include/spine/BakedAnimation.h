@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_BAKEDANIMATION_H_
+#define SPINE_BAKEDANIMATION_H_
+
+#include <spine/Animation.h>
+#include <spine/Skeleton.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+	SP_BAKED_LOCAL, /* x, y, rotation, scaleX, scaleY, flipX, flipY per bone, mix and bendDirection per IK constraint. */
+	SP_BAKED_WORLD /* m00, m01, worldX, m10, m11, worldY per bone. */
+} spBakedSpace;
+
+/* An animation sampled at a fixed rate, for skeletons that don't need curves, keyframe searches or IK. Slot colors and
+ * attachments are baked in both spaces. Draw order, FFD and events are not baked. */
+typedef struct spBakedAnimation {
+	const spAnimation* const animation;
+	spBakedSpace const space;
+	float const frameRate;
+	int const framesCount;
+	int const bonesCount, slotsCount, ikConstraintsCount;
+	float* const bones; /* Per frame, the values of each bone for the space. */
+	float* const ikConstraints; /* Per frame, mix, bendDirection, ... Only for SP_BAKED_LOCAL. */
+	float* const slots; /* Per frame, r, g, b, a, ... */
+	spAttachment** const attachments; /* Per frame, the attachment of each slot. */
+	/* The largest distance between a bone's world position from the live animation and from the baked frames, measured
+	 * halfway between each pair of frames. Only bone positions are measured, see unbaked. */
+	float const error;
+	/* True when the animation has draw order or FFD timelines. They are not baked, so the baked animation does not match the
+	 * live animation however small error is. */
+	int/*bool*/const unbaked;
+
+#ifdef __cplusplus
+	spBakedAnimation() :
+		animation(0),
+		space(SP_BAKED_LOCAL),
+		frameRate(0),
+		framesCount(0),
+		bonesCount(0), slotsCount(0), ikConstraintsCount(0),
+		bones(0),
+		ikConstraints(0),
+		slots(0),
+		attachments(0),
+		error(0),
+		unbaked(0) {
+	}
+#endif
+} spBakedAnimation;
+
+/* Samples the animation on the skeleton from its setup pose at frameRate frames per second, eg 30, using spAnimation_apply
+ * and spSkeleton_updateWorldTransform. Attachments are resolved with the skeleton's skin, and SP_BAKED_WORLD matrices include
+ * the skeleton's flips and spBone_isYDown. The skeleton's pose is restored afterward. Returns 0 if frameRate is not > 0. */
+spBakedAnimation* spBakedAnimation_create (spSkeleton* skeleton, const spAnimation* animation, float frameRate,
+		spBakedSpace space);
+void spBakedAnimation_dispose (spBakedAnimation* self);
+
+/* Poses the skeleton by interpolating between the two baked frames around time, replacing spAnimationState_apply. For
+ * SP_BAKED_LOCAL, spSkeleton_updateWorldTransform must be called afterward. For SP_BAKED_WORLD, the bone matrices are set
+ * directly and must not be updated, other world values are not set. */
+void spBakedAnimation_apply (const spBakedAnimation* self, spSkeleton* skeleton, float time, int/*bool*/loop);
+
+#ifdef SPINE_SHORT_NAMES
+typedef spBakedAnimation BakedAnimation;
+#define BAKED_LOCAL SP_BAKED_LOCAL
+#define BAKED_WORLD SP_BAKED_WORLD
+#define BakedAnimation_create(...) spBakedAnimation_create(__VA_ARGS__)
+#define BakedAnimation_dispose(...) spBakedAnimation_dispose(__VA_ARGS__)
+#define BakedAnimation_apply(...) spBakedAnimation_apply(__VA_ARGS__)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_BAKEDANIMATION_H_ */
@@ -45,6 +45,8 @@ struct spBone {
 	spBoneData* const data;
 	struct spSkeleton* const skeleton;
 	spBone* const parent;
+	/* The fields from x to flipY are copied as one block when a skeleton is reset to its setup pose or a pose is captured
+	 * or applied, see Skeleton.c and SkeletonPose.c. Keep them together and in this order. */
 	float x, y;
 	float rotation, rotationIK;
 	float scaleX, scaleY;
@@ -86,6 +88,11 @@ void spBone_setToSetupPose (spBone* self);
 
 void spBone_updateWorldTransform (spBone* self);
 
+/* Flags the local transform as changed so spSkeleton_updateWorldTransformIncremental recomputes the bone and its descendants.
+ * Timelines and spBone_setToSetupPose call this. It must be called after setting x, y, rotation, scaleX, scaleY, flipX or
+ * flipY directly, and on the first bone of an IK constraint after setting its mix or bendDirection directly. */
+void spBone_markDirty (spBone* self);
+
 void spBone_worldToLocal (spBone* self, float worldX, float worldY, float* localX, float* localY);
 void spBone_localToWorld (spBone* self, float localX, float localY, float* worldX, float* worldY);
 
@@ -97,6 +104,7 @@ typedef spBone Bone;
 #define Bone_dispose(...) spBone_dispose(__VA_ARGS__)
 #define Bone_setToSetupPose(...) spBone_setToSetupPose(__VA_ARGS__)
 #define Bone_updateWorldTransform(...) spBone_updateWorldTransform(__VA_ARGS__)
+#define Bone_markDirty(...) spBone_markDirty(__VA_ARGS__)
 #define Bone_worldToLocal(...) spBone_worldToLocal(__VA_ARGS__)
 #define Bone_localToWorld(...) spBone_localToWorld(__VA_ARGS__)
 #endif
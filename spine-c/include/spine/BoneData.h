@@ -38,6 +38,8 @@ extern "C" {
 
 typedef struct spBoneData spBoneData;
 struct spBoneData {
+	/* The index of this bone in spSkeletonData bones, set when the bone data is added to the skeleton data. */
+	const int index;
 	const char* const name;
 	spBoneData* const parent;
 	float length;
@@ -49,6 +51,7 @@ struct spBoneData {
 
 #ifdef __cplusplus
 	spBoneData() :
+		index(0),
 		name(0),
 		parent(0),
 		length(0),
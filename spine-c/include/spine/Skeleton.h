@@ -84,13 +84,41 @@ typedef struct spSkeleton {
 #endif
 } spSkeleton;
 
+/* The skeleton and its bones, slots, IK constraints and their arrays are allocated as a single block. Objects or arrays later
+ * replaced by the user are freed individually by spSkeleton_dispose. */
 spSkeleton* spSkeleton_create (spSkeletonData* data);
 void spSkeleton_dispose (spSkeleton* self);
 
-/* Caches information about bones and IK constraints. Must be called if bones or IK constraints are added or removed. */
+/* Copies the skeleton's complete state, including its skin, attachments, draw order, bone and IK constraint poses and world
+ * transforms, without any lookups. Returns 0 if bones, slots, IK constraints or their arrays were replaced since
+ * spSkeleton_create or spSkeleton_clone. */
+spSkeleton* spSkeleton_clone (const spSkeleton* self);
+
+/* Caches information about bones and IK constraints. Must be called if bones or IK constraints are added or removed. The
+ * skeleton data's update order is shared when the bones and IK constraints match the data. */
 void spSkeleton_updateCache (const spSkeleton* self);
 void spSkeleton_updateWorldTransform (const spSkeleton* self);
-
+/* Recomputes only the bones whose local transform was flagged with spBone_markDirty, their descendants and bones affected by
+ * IK constraints whose inputs changed. Results are identical to spSkeleton_updateWorldTransform. Falls back to a full update
+ * when needed, eg the first time. Returns the number of bones updated. */
+int spSkeleton_updateWorldTransformIncremental (const spSkeleton* self);
+/* Updates the world transforms of many skeletons, processing the same bone of up to 4 skeletons at once using SIMD when
+ * available. Consecutive skeletons that share the same spSkeletonData are batched together, so skeletons should be grouped by
+ * skeleton data. Results are identical to calling spSkeleton_updateWorldTransform for each skeleton, provided the runtime is
+ * built without floating point contraction, see extension.h. */
+void spSkeleton_updateWorldTransformBatch (spSkeleton** skeletons, int count);
+
+/* Writes each bone's world transform as a 2x3 matrix, m00 m01 worldX m10 m11 worldY, to out + boneIndex * stride. stride is in
+ * floats and must be at least 6. The skeleton's x and y are not included, add them to the transformed vertices as
+ * spRegionAttachment_computeWorldVertices and the mesh computeWorldVertices functions do. */
+void spSkeleton_writeBoneMatrices (const spSkeleton* self, float* out, int stride);
+/* Same as spSkeleton_updateWorldTransform followed by spSkeleton_writeBoneMatrices, but writes each matrix as soon as its bone
+ * is updated, so the bones are read only once. out may be a mapped GPU buffer, it is only written. */
+void spSkeleton_updateWorldTransformTo (const spSkeleton* self, float* out, int stride);
+
+/* The setup pose is captured from the skeleton data on first use, so resetting copies from a packed image without lookups.
+ * Slot attachments are resolved again when the skin changes. Call spSkeleton_updateCache after changing setup pose values in
+ * the skeleton data or the attachments of a skin. */
 void spSkeleton_setToSetupPose (const spSkeleton* self);
 void spSkeleton_setBonesToSetupPose (const spSkeleton* self);
 void spSkeleton_setSlotsToSetupPose (const spSkeleton* self);
@@ -131,7 +159,12 @@ void spSkeleton_update (spSkeleton* self, float deltaTime);
 typedef spSkeleton Skeleton;
 #define Skeleton_create(...) spSkeleton_create(__VA_ARGS__)
 #define Skeleton_dispose(...) spSkeleton_dispose(__VA_ARGS__)
+#define Skeleton_clone(...) spSkeleton_clone(__VA_ARGS__)
 #define Skeleton_updateWorldTransform(...) spSkeleton_updateWorldTransform(__VA_ARGS__)
+#define Skeleton_updateWorldTransformIncremental(...) spSkeleton_updateWorldTransformIncremental(__VA_ARGS__)
+#define Skeleton_updateWorldTransformBatch(...) spSkeleton_updateWorldTransformBatch(__VA_ARGS__)
+#define Skeleton_writeBoneMatrices(...) spSkeleton_writeBoneMatrices(__VA_ARGS__)
+#define Skeleton_updateWorldTransformTo(...) spSkeleton_updateWorldTransformTo(__VA_ARGS__)
 #define Skeleton_setToSetupPose(...) spSkeleton_setToSetupPose(__VA_ARGS__)
 #define Skeleton_setBonesToSetupPose(...) spSkeleton_setBonesToSetupPose(__VA_ARGS__)
 #define Skeleton_setSlotsToSetupPose(...) spSkeleton_setSlotsToSetupPose(__VA_ARGS__)
@@ -43,6 +43,8 @@
 extern "C" {
 #endif
 
+struct spUpdateOrder;
+
 typedef struct spSkeletonData {
 	const char* version;
 	const char* hash;
@@ -71,6 +73,15 @@ typedef struct spSkeletonData {
 spSkeletonData* spSkeletonData_create ();
 void spSkeletonData_dispose (spSkeletonData* self);
 
+/* Returns the bone update order shared by skeletons created from this data. It is computed on first use, which is not thread
+ * safe, so bones and IK constraints must not be added or removed afterward. */
+const struct spUpdateOrder* spSkeletonData_getUpdateOrder (const spSkeletonData* self);
+
+/* Indexes the names of the bones, slots, skins, events, animations and IK constraints so the find functions use hash lookups
+ * rather than scanning. SkeletonJson calls this while loading. It must be called again after items are added, removed or
+ * replaced, and not while other threads use the skeleton data. Until then the find functions scan. */
+void spSkeletonData_buildNameTables (spSkeletonData* self);
+
 spBoneData* spSkeletonData_findBone (const spSkeletonData* self, const char* boneName);
 int spSkeletonData_findBoneIndex (const spSkeletonData* self, const char* boneName);
 
@@ -89,6 +100,8 @@ spIkConstraintData* spSkeletonData_findIkConstraint (const spSkeletonData* self,
 typedef spSkeletonData SkeletonData;
 #define SkeletonData_create(...) spSkeletonData_create(__VA_ARGS__)
 #define SkeletonData_dispose(...) spSkeletonData_dispose(__VA_ARGS__)
+#define SkeletonData_getUpdateOrder(...) spSkeletonData_getUpdateOrder(__VA_ARGS__)
+#define SkeletonData_buildNameTables(...) spSkeletonData_buildNameTables(__VA_ARGS__)
 #define SkeletonData_findBone(...) spSkeletonData_findBone(__VA_ARGS__)
 #define SkeletonData_findBoneIndex(...) spSkeletonData_findBoneIndex(__VA_ARGS__)
 #define SkeletonData_findSlot(...) spSkeletonData_findSlot(__VA_ARGS__)
@@ -44,6 +44,8 @@ extern "C" {
 
 typedef struct spSkeletonJson {
 	float scale;
+	/* The lookupError given to the curve timelines this loader reads, see spCurveTimeline. Default is 0. */
+	float curveLookupError;
 	spAttachmentLoader* attachmentLoader;
 	const char* const error;
 } spSkeletonJson;
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONPOSE_H_
+#define SPINE_SKELETONPOSE_H_
+
+#include <spine/Skeleton.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Storage for the mutable state of a skeleton: bone local transforms including rotationIK, slot colors, attachments,
+ * attachment times and vertices, draw order, IK constraint mix and bend direction, and the skeleton's skin, color, time, flips
+ * and position. World transforms are not stored. */
+typedef struct spSkeletonPose {
+	int const bonesCount;
+	int const slotsCount;
+	int const ikConstraintsCount;
+
+#ifdef __cplusplus
+	spSkeletonPose() :
+		bonesCount(0),
+		slotsCount(0),
+		ikConstraintsCount(0) {
+	}
+#endif
+} spSkeletonPose;
+
+/* Creates a pose sized for the skeleton. Room for attachment vertices is reserved for the largest FFD frames of the skeleton
+ * data's animations, so saving and restoring do not allocate unless a slot's attachment vertices are set some other way. */
+spSkeletonPose* spSkeletonPose_create (const spSkeleton* skeleton);
+void spSkeletonPose_dispose (spSkeletonPose* self);
+
+/* The skeleton must have the same bones, slots and IK constraints as the skeleton the pose was created for. */
+void spSkeleton_savePose (const spSkeleton* self, spSkeletonPose* pose);
+/* Marks all bones dirty. spSkeleton_updateWorldTransform must be called before world transforms are used. */
+void spSkeleton_restorePose (spSkeleton* self, const spSkeletonPose* pose);
+/* Restores only what the animation's timelines set when it is applied again at time: the bone rotations, translations and
+ * scales, slot colors, attachment vertices, IK constraints and draw order it keys. With a pose saved right after applying the
+ * animation at time, this holds the animation's pose without applying it. Slot attachments and bone flips are not restored:
+ * their timelines only set them when a key is crossed, so restoring them on every frame would undo keys of an animation
+ * applied afterward. Returns 0 and restores nothing if the animation has timelines of unknown types. */
+int/*bool*/spSkeleton_restoreAnimationPose (spSkeleton* self, const spSkeletonPose* pose, const spAnimation* animation,
+		float time, int/*bool*/loop);
+
+#ifdef SPINE_SHORT_NAMES
+typedef spSkeletonPose SkeletonPose;
+#define SkeletonPose_create(...) spSkeletonPose_create(__VA_ARGS__)
+#define SkeletonPose_dispose(...) spSkeletonPose_dispose(__VA_ARGS__)
+#define Skeleton_savePose(...) spSkeleton_savePose(__VA_ARGS__)
+#define Skeleton_restorePose(...) spSkeleton_restorePose(__VA_ARGS__)
+#define Skeleton_restoreAnimationPose(...) spSkeleton_restoreAnimationPose(__VA_ARGS__)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_SKELETONPOSE_H_ */
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONTRANSFORMS_H_
+#define SPINE_SKELETONTRANSFORMS_H_
+
+#include <spine/Skeleton.h>
+#include <spine/UpdateOrder.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Structure of arrays storing the bone transforms of a skeleton contiguously, indexed by bone index. The arrays are the source
+ * of truth: spSkeletonTransforms_update reads the local transforms and IK constraint settings and writes the world transforms
+ * without touching any spBone, following parents and IK constraints by index. Copying from and to the bones are explicit,
+ * optional steps. */
+typedef struct spSkeletonTransforms {
+	int const bonesCount;
+	const int* const parentIndices; /* -1 for the root bone. Parents come before their children. */
+	const int* const inheritScale;
+	const int* const inheritRotation;
+	const float* const length;
+
+	/* Local transforms. */
+	float* const x;
+	float* const y;
+	float* const rotation;
+	float* const scaleX;
+	float* const scaleY;
+	int* const flipX;
+	int* const flipY;
+
+	/* World transforms, computed by spSkeletonTransforms_update. rotationIK is rotation after IK constraints are applied. */
+	float* const rotationIK;
+	float* const m00;
+	float* const m01;
+	float* const worldX;
+	float* const m10;
+	float* const m11;
+	float* const worldY;
+	float* const worldRotation;
+	float* const worldScaleX;
+	float* const worldScaleY;
+	int* const worldFlipX;
+	int* const worldFlipY;
+
+	/* IK constraints, in the skeleton data's order. */
+	int const ikConstraintsCount;
+	const int* const ikBones; /* Two bone indices per constraint, the second -1 for a single bone. */
+	const int* const ikTargets;
+	int* const ikBendDirections;
+	float* const ikMixes;
+
+	const struct spUpdateOrder* const updateOrder; /* Shared with the skeleton data. */
+
+#ifdef __cplusplus
+	spSkeletonTransforms() :
+		bonesCount(0),
+		parentIndices(0),
+		inheritScale(0),
+		inheritRotation(0),
+		length(0),
+		x(0), y(0),
+		rotation(0),
+		scaleX(0), scaleY(0),
+		flipX(0), flipY(0),
+		rotationIK(0),
+		m00(0), m01(0), worldX(0),
+		m10(0), m11(0), worldY(0),
+		worldRotation(0),
+		worldScaleX(0), worldScaleY(0),
+		worldFlipX(0), worldFlipY(0),
+		ikConstraintsCount(0),
+		ikBones(0),
+		ikTargets(0),
+		ikBendDirections(0),
+		ikMixes(0),
+		updateOrder(0) {
+	}
+#endif
+} spSkeletonTransforms;
+
+/* The arrays are allocated in a single block with the struct. The local transforms and IK constraints start as the setup pose.
+ * The skeleton data's bones must be ordered with parents before their children, as SkeletonJson reads them. */
+spSkeletonTransforms* spSkeletonTransforms_create (const spSkeletonData* data);
+void spSkeletonTransforms_dispose (spSkeletonTransforms* self);
+
+/* Copies the local transforms of the skeleton's bones and the mix and bend direction of its IK constraints to the arrays. */
+void spSkeletonTransforms_readBones (spSkeletonTransforms* self, const spSkeleton* skeleton);
+
+/* Computes the world transforms from the arrays in the skeleton data's update order, applying IK constraints between
+ * segments, with the same results as spSkeleton_updateWorldTransform for a skeleton with the same pose. */
+void spSkeletonTransforms_update (spSkeletonTransforms* self, int/*bool*/flipX, int/*bool*/flipY);
+
+/* Copies the world transforms and rotationIK to the skeleton's bones, so the spBone API can be used for rendering. */
+void spSkeletonTransforms_writeBones (const spSkeletonTransforms* self, spSkeleton* skeleton);
+
+#ifdef SPINE_SHORT_NAMES
+typedef spSkeletonTransforms SkeletonTransforms;
+#define SkeletonTransforms_create(...) spSkeletonTransforms_create(__VA_ARGS__)
+#define SkeletonTransforms_dispose(...) spSkeletonTransforms_dispose(__VA_ARGS__)
+#define SkeletonTransforms_readBones(...) spSkeletonTransforms_readBones(__VA_ARGS__)
+#define SkeletonTransforms_update(...) spSkeletonTransforms_update(__VA_ARGS__)
+#define SkeletonTransforms_writeBones(...) spSkeletonTransforms_writeBones(__VA_ARGS__)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_SKELETONTRANSFORMS_H_ */
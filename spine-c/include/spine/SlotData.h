@@ -43,6 +43,8 @@ typedef enum {
 } spBlendMode;
 
 typedef struct spSlotData {
+	/* The index of this slot in spSkeletonData slots, set when the slot data is added to the skeleton data. */
+	const int index;
 	const char* const name;
 	const spBoneData* const boneData;
 	const char* attachmentName;
@@ -51,6 +53,7 @@ typedef struct spSlotData {
 
 #ifdef __cplusplus
 	spSlotData() :
+		index(0),
 		name(0),
 		boneData(0),
 		attachmentName(0),
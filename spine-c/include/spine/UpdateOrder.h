@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_UPDATEORDER_H_
+#define SPINE_UPDATEORDER_H_
+
+#include <spine/SkeletonData.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The order in which a skeleton's bones have their world transforms computed. Bones are updated in segments, with IK
+ * constraint i applied after segment i. Bones affected by IK constraint i are in both segment i and i + 1, so they are
+ * updated before and after the constraint is applied. */
+typedef struct spUpdateOrder {
+	int const bonesCount;
+	int const ikConstraintsCount;
+
+	int const indicesCount;
+	const int* const indices; /* Bone indices in update order. */
+	const int* const segmentEnds; /* ikConstraintsCount + 1 entries, segment i ends before indices[segmentEnds[i]]. */
+	const int* const ikIndices; /* Per bone, the IK constraint applied between its two updates, or -1. */
+
+#ifdef __cplusplus
+	spUpdateOrder() :
+		bonesCount(0),
+		ikConstraintsCount(0),
+		indicesCount(0),
+		indices(0),
+		segmentEnds(0),
+		ikIndices(0) {
+	}
+#endif
+} spUpdateOrder;
+
+/* Computes the update order in time linear to the number of bones and IK constraint bones. Bones are identified by their
+ * spBoneData index. */
+spUpdateOrder* spUpdateOrder_create (const spSkeletonData* data);
+void spUpdateOrder_dispose (spUpdateOrder* self);
+
+#ifdef SPINE_SHORT_NAMES
+typedef spUpdateOrder UpdateOrder;
+#define UpdateOrder_create(...) spUpdateOrder_create(__VA_ARGS__)
+#define UpdateOrder_dispose(...) spUpdateOrder_dispose(__VA_ARGS__)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_UPDATEORDER_H_ */
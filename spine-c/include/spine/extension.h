@@ -57,6 +57,14 @@
 /* Allocates a new char[], assigns it to TO, and copies FROM to it. Can be used on const types. */
 #define MALLOC_STR(TO,FROM) strcpy(CONST_CAST(char*, TO) = (char*)MALLOC(char, strlen(FROM) + 1), FROM)
 
+/* Multiplies and adds must not be fused, so batched and SIMD code gives the same results as the scalar code. GCC needs
+ * -ffp-contract=off, which the Makefile and Eclipse project pass. */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+#pragma fp_contract (off)
+#endif
+
 #define PI 3.1415926535897932385f
 #define DEG_RAD (PI / 180)
 #define RAD_DEG (180 / PI)
@@ -77,6 +85,22 @@
 #define ACOS(A) (float)acos(A)
 #endif
 
+/* Defining SPINE_FAST_TRIG replaces the libm trig functions with polynomial approximations, see _spSin. SIN_COS computes both
+ * values, sharing the range reduction when it can. */
+#ifdef SPINE_FAST_TRIG
+#undef ATAN2
+#undef SIN
+#undef COS
+#undef ACOS
+#define ATAN2(A,B) _spAtan2(A, B)
+#define SIN(A) _spSin(A)
+#define COS(A) _spCos(A)
+#define ACOS(A) _spAcos(A)
+#define SIN_COS(A,S,C) _spSinCos(A, &(S), &(C))
+#else
+#define SIN_COS(A,S,C) ((S) = SIN(A), (C) = COS(A))
+#endif
+
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -89,6 +113,8 @@
 #include <spine/SkinnedMeshAttachment.h>
 #include <spine/BoundingBoxAttachment.h>
 #include <spine/AnimationState.h>
+#include <spine/UpdateOrder.h>
+#include <spine/SkeletonPose.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -122,30 +148,278 @@ void _setFree (void (*_free) (void* ptr));
 
 char* _readFile (const char* path, int* length);
 
+/* Polynomial approximations used when SPINE_FAST_TRIG is defined. Measured maximum absolute errors: sin and cos 1e-7 for
+ * |x| <= 2000 radians, atan2 3e-7, acos 5e-7. Accuracy of sin and cos degrades with larger arguments. */
+float _spSin (float x);
+float _spCos (float x);
+void _spSinCos (float x, float* sine, float* cosine);
+float _spAtan2 (float y, float x);
+float _spAcos (float x);
+
+/* Open-addressing table mapping names to indices in an array of pointers to structs that have a name field. */
+typedef struct _spNameTable {
+	const void* items; /* The array that was indexed. */
+	int count; /* The number of items indexed, 0 when not built. */
+	int capacity; /* Power of two, 0 until the table is first built. */
+	struct _spNameTableEntry* entries;
+
+#ifdef __cplusplus
+	_spNameTable() :
+		items(0),
+		count(0),
+		capacity(0),
+		entries(0) {
+	}
+#endif
+} _spNameTable;
+
+/* Indexes count items. nameOffset is the offset of the name field in the items' struct. Items appended since the last call are
+ * added to the table, and the table is rebuilt if the array was replaced or shrunk. Small arrays are not indexed. */
+void _spNameTable_build (_spNameTable* self, const void* items, int count, size_t nameOffset);
+/* Returns the index of the first of count items with the specified name, or -1. Never modifies the table, so it is safe to call
+ * from multiple threads. Scans the items when the table was not built for exactly these items. */
+int _spNameTable_find (const _spNameTable* self, const void* items, int count, size_t nameOffset, const char* name);
+void _spNameTable_dispose (_spNameTable* self);
+
 /**/
 
 typedef struct _spAnimationState {
 	spAnimationState super;
-	spEvent** events;
+	int eventsCapacity;
+	spEvent** events; /* Events fired by one track's animation in apply. */
+
+	int queueCapacity, queueStart, queueCount;
+	spTrackEvent* queue; /* Ring buffer of events deferred until spAnimationState_drainEvents. */
+
+	spTrackEntry* entryPool; /* Disposed entries kept for reuse, linked by next. */
+	spTrackEntryPoolStats entryPoolStats;
 
 	spTrackEntry* (*createTrackEntry) (spAnimationState* self);
 	void (*disposeTrackEntry) (spTrackEntry* entry);
+	/* When set, a disposed entry keeps its rendererObject in the pool and this is called for it when the pool frees the entry.
+	 * Otherwise rendererObject is cleared and disposeTrackEntry must free it. */
+	void (*disposeRendererObject) (void* rendererObject);
 
 #ifdef __cplusplus
 	_spAnimationState() :
 		super(),
+		eventsCapacity(0),
 		events(0),
+		queueCapacity(0), queueStart(0), queueCount(0),
+		queue(0),
+		entryPool(0),
+		entryPoolStats(),
 		createTrackEntry(0),
-		disposeTrackEntry(0) {
+		disposeTrackEntry(0),
+		disposeRendererObject(0) {
 	}
 #endif
 } _spAnimationState;
 
+typedef struct _spTrackEntry {
+	spTrackEntry super;
+	int serial; /* Incremented each time the entry is reused from the pool, so a reused entry can be told apart. */
+	int cursorsCount;
+	int* cursors; /* Keyframe cursors for the animation's timelines, see spAnimation_mixWithCursors. */
+	const spAnimation* eventsAnimation;
+	int eventsCount; /* Most events eventsAnimation can fire in one apply. */
+	int eventTimelinesCount, eventTimelinesCapacity;
+	int* eventTimelines; /* Indices of eventsAnimation's event timelines. */
+	spSkeletonPose* previousPose; /* The previous entry's pose when the mix started, see spAnimationState freezeMixes. */
+	int previousPoseState; /* 0 if not saved, 1 if saved, -1 if the previous animation can't be restored. */
+	float previousPoseTime;
+
+#ifdef __cplusplus
+	_spTrackEntry() :
+		super(),
+		serial(0),
+		cursorsCount(0),
+		cursors(0),
+		eventsAnimation(0),
+		eventsCount(0),
+		eventTimelinesCount(0), eventTimelinesCapacity(0),
+		eventTimelines(0),
+		previousPose(0),
+		previousPoseState(0),
+		previousPoseTime(0) {
+	}
+#endif
+} _spTrackEntry;
+
+/* createTrackEntry must return entries created by _spTrackEntry_create, which reuses entries from the state's pool. */
 spTrackEntry* _spTrackEntry_create (spAnimationState* self);
+/* Disposes the entry's previous entry with disposeTrackEntry and returns the entry to the state's pool. */
 void _spTrackEntry_dispose (spTrackEntry* self);
 
 /**/
 
+typedef struct _spBone {
+	spBone super;
+	int/*bool*/dirty; /* Set when the local transform changes, cleared by the skeleton's world transform update. */
+	int/*bool*/changed; /* Scratch flag for spSkeleton_updateWorldTransformIncremental. */
+	int index; /* Index in the skeleton's bones, set by spSkeleton_updateCache. */
+	float trigRotation; /* The worldRotation that cosine and sine were computed for. */
+	float cosine, sine;
+
+#ifdef __cplusplus
+	_spBone() :
+		super(),
+		dirty(0),
+		changed(0),
+		index(0),
+		trigRotation(0),
+		cosine(1),
+		sine(0) {
+	}
+#endif
+} _spBone;
+
+void _spBone_init (spBone* self, spBoneData* data, spSkeleton* skeleton, spBone* parent);
+
+/* Gets the cosine and sine of worldRotation, which is in degrees. They are only recomputed when worldRotation differs from the
+ * previous call for this bone. */
+void _spBone_cosSin (spBone* self, float worldRotation, float* cosine, float* sine);
+
+/* Updates the world transforms of up to 4 bones that have the same spBoneData and whose parents are already updated. Gives the
+ * same results as calling spBone_updateWorldTransform for each bone when floating point contraction is disabled, see Simd.h. */
+void _spBone_updateWorldTransforms (spBone** bones, int count);
+
+#ifdef SPINE_SHORT_NAMES
+#define _Bone_init(...) _spBone_init(__VA_ARGS__)
+#define _Bone_updateWorldTransforms(...) _spBone_updateWorldTransforms(__VA_ARGS__)
+#define _Bone_cosSin(...) _spBone_cosSin(__VA_ARGS__)
+#endif
+
+/**/
+
+typedef struct _spSlot {
+	spSlot super;
+	float attachmentTime;
+
+#ifdef __cplusplus
+	_spSlot() :
+		super(),
+		attachmentTime(0) {
+	}
+#endif
+} _spSlot;
+
+void _spSlot_init (spSlot* self, spSlotData* data, spBone* bone);
+/* Returns the slot's setup pose attachment from the skeleton's skin or the default skin, or 0. */
+spAttachment* _spSlot_getSetupAttachment (const spSlot* self);
+
+#ifdef SPINE_SHORT_NAMES
+#define _Slot_init(...) _spSlot_init(__VA_ARGS__)
+#define _Slot_getSetupAttachment(...) _spSlot_getSetupAttachment(__VA_ARGS__)
+#endif
+
+/**/
+
+/* @param bones Storage for data->bonesCount bones, already set. */
+void _spIkConstraint_init (spIkConstraint* self, spIkConstraintData* data, spBone** bones, spBone* target);
+
+#ifdef SPINE_SHORT_NAMES
+#define _IkConstraint_init(...) _spIkConstraint_init(__VA_ARGS__)
+#endif
+
+/**/
+
+typedef struct _spSkeletonData {
+	spSkeletonData super;
+	spUpdateOrder* updateOrder;
+	_spNameTable bonesTable, slotsTable, skinsTable, eventsTable, animationsTable, ikConstraintsTable;
+
+#ifdef __cplusplus
+	_spSkeletonData() :
+		super(),
+		updateOrder(0),
+		bonesTable(),
+		slotsTable(),
+		skinsTable(),
+		eventsTable(),
+		animationsTable(),
+		ikConstraintsTable() {
+	}
+#endif
+} _spSkeletonData;
+
+int _spSkeletonData_findIkConstraintIndex (const spSkeletonData* self, const char* ikConstraintName);
+
+#ifdef SPINE_SHORT_NAMES
+#define _SkeletonData_findIkConstraintIndex(...) _spSkeletonData_findIkConstraintIndex(__VA_ARGS__)
+#endif
+
+/**/
+
+/* Computes an update order from bone and IK constraint chain indices, -1 for no parent. */
+spUpdateOrder* _spUpdateOrder_create (int bonesCount, const int* parents, int ikConstraintsCount, const int* ikParents,
+		const int* ikChildren);
+
+#ifdef SPINE_SHORT_NAMES
+#define _UpdateOrder_create(...) _spUpdateOrder_create(__VA_ARGS__)
+#endif
+
+/**/
+
+/* Number of attachments resolved by attachment timelines that each skeleton caches, a power of two. */
+#define TIMELINE_ATTACHMENTS_SIZE 64
+
+/* The attachment of an attachment timeline's frame for a skin and default skin. timeline is 0 for an empty entry and a skin is
+ * 0 for none. The revisions come from unsynchronized counters, so the pointers are part of the key too. */
+typedef struct _spTimelineAttachment {
+	const spTimeline* timeline;
+	const spSkin* skin;
+	const spSkin* defaultSkin;
+	int timelineRevision, frameIndex;
+	int skinRevision, defaultSkinRevision;
+	spAttachment* attachment;
+} _spTimelineAttachment;
+
+typedef struct _spSkeleton {
+	spSkeleton super;
+
+	const spUpdateOrder* updateOrder; /* Shared with the skeleton data unless ownUpdateOrder is set. */
+	spUpdateOrder* ownUpdateOrder;
+
+	size_t size; /* Size of the block holding the skeleton and the objects created with it. */
+
+	struct _spSetupPose* setupPose; /* Built on first use, freed by spSkeleton_updateCache. */
+
+	int* ikChanged;
+	int/*bool*/incremental; /* False if the update order reads bones before updating them, forcing full updates. */
+	int/*bool*/worldValid; /* True once the world transforms have been computed for the current update order. */
+	int/*bool*/lastFlipX, lastFlipY, lastYDown;
+
+	/* Direct mapped by a hash of the timeline and frame: an entry is overwritten when another frame hashes to it, and the
+	 * attachment is then looked up again. 48 bytes per entry with 64 bit pointers, 3 KB per skeleton. */
+	_spTimelineAttachment timelineAttachments[TIMELINE_ATTACHMENTS_SIZE];
+
+#ifdef __cplusplus
+	_spSkeleton() :
+		super(),
+		updateOrder(0),
+		ownUpdateOrder(0),
+		size(0),
+		setupPose(0),
+		ikChanged(0),
+		incremental(0),
+		worldValid(0),
+		lastFlipX(0), lastFlipY(0), lastYDown(0) {
+	}
+#endif
+} _spSkeleton;
+
+/**/
+
+/* Changes when an attachment is added to the skin. Caches of resolved attachments key on the skin pointer and its revision. */
+int _spSkin_getRevision (const spSkin* self);
+
+#ifdef SPINE_SHORT_NAMES
+#define _Skin_getRevision(...) _spSkin_getRevision(__VA_ARGS__)
+#endif
+
+/**/
+
 void _spAttachmentLoader_init (spAttachmentLoader* self, /**/
 void (*dispose) (spAttachmentLoader* self), /**/
 		spAttachment* (*newAttachment) (spAttachmentLoader* self, spSkin* skin, spAttachmentType type, const char* name,
@@ -174,14 +448,25 @@ void _spAttachment_deinit (spAttachment* self);
 
 /**/
 
+typedef struct _spTimelineVtable {
+	/* @param cursor 0 or the timeline's cursor, see spAnimation_mixWithCursors. */
+	void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
+			int* eventsCount, float alpha, int* cursor);
+	void (*dispose) (spTimeline* self);
+} _spTimelineVtable;
+
+/* Allocates a vtable for the timeline, freed by _spTimeline_deinit. apply is not given a cursor. */
 void _spTimeline_init (spTimeline* self, spTimelineType type, /**/
 void (*dispose) (spTimeline* self), /**/
 		void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
 				int* eventsCount, float alpha));
+/* @param vtable Shared by all timelines of the type, usually static. It is not freed. */
+void _spTimeline_initWithVtable (spTimeline* self, spTimelineType type, const _spTimelineVtable* vtable);
 void _spTimeline_deinit (spTimeline* self);
 
 #ifdef SPINE_SHORT_NAMES
 #define _Timeline_init(...) _spTimeline_init(__VA_ARGS__)
+#define _Timeline_initWithVtable(...) _spTimeline_initWithVtable(__VA_ARGS__)
 #define _Timeline_deinit(...) _spTimeline_deinit(__VA_ARGS__)
 #endif
 
@@ -191,13 +476,25 @@ void _spCurveTimeline_init (spCurveTimeline* self, spTimelineType type, int fram
 void (*dispose) (spTimeline* self), /**/
 		void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
 				int* eventsCount, float alpha));
+void _spCurveTimeline_initWithVtable (spCurveTimeline* self, spTimelineType type, int framesCount,
+		const _spTimelineVtable* vtable);
 void _spCurveTimeline_deinit (spCurveTimeline* self);
 
 #ifdef SPINE_SHORT_NAMES
 #define _CurveTimeline_init(...) _spCurveTimeline_init(__VA_ARGS__)
+#define _CurveTimeline_initWithVtable(...) _spCurveTimeline_initWithVtable(__VA_ARGS__)
 #define _CurveTimeline_deinit(...) _spCurveTimeline_deinit(__VA_ARGS__)
 #endif
 
+/**/
+
+/* Returns the index of the bone, slot or IK constraint the timeline keys, or -1 for draw order and event timelines and
+ * timelines of unknown types. */
+int _spTimeline_getIndex (const spTimeline* timeline);
+/* Returns the time of the timeline's first frame, before which applying it changes nothing, or -1 for timelines of unknown
+ * types. */
+float _spTimeline_getStartTime (const spTimeline* timeline);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,7 @@
 #include <spine/IkConstraint.h>
 #include <limits.h>
 #include <spine/extension.h>
+#include "Simd.h"
 
 spAnimation* spAnimation_create (const char* name, int timelinesCount) {
 	spAnimation* self = NEW(spAnimation);
@@ -53,50 +54,47 @@ void spAnimation_dispose (spAnimation* self) {
 
 void spAnimation_apply (const spAnimation* self, spSkeleton* skeleton, float lastTime, float time, int loop, spEvent** events,
 		int* eventsCount) {
-	int i, n = self->timelinesCount;
-
-	if (loop && self->duration) {
-		time = FMOD(time, self->duration);
-		lastTime = FMOD(lastTime, self->duration);
-	}
-
-	for (i = 0; i < n; ++i)
-		spTimeline_apply(self->timelines[i], skeleton, lastTime, time, events, eventsCount, 1);
+	spAnimation_mixWithCursors(self, skeleton, lastTime, time, loop, events, eventsCount, 1, 0);
 }
 
 void spAnimation_mix (const spAnimation* self, spSkeleton* skeleton, float lastTime, float time, int loop, spEvent** events,
 		int* eventsCount, float alpha) {
-	int i, n = self->timelinesCount;
-
-	if (loop && self->duration) {
-		time = FMOD(time, self->duration);
-		lastTime = FMOD(lastTime, self->duration);
-	}
-
-	for (i = 0; i < n; ++i)
-		spTimeline_apply(self->timelines[i], skeleton, lastTime, time, events, eventsCount, alpha);
+	spAnimation_mixWithCursors(self, skeleton, lastTime, time, loop, events, eventsCount, alpha, 0);
 }
 
 /**/
 
-typedef struct _spTimelineVtable {
+/* The vtable of a timeline initialized with _spTimeline_init, owned by the timeline. */
+typedef struct {
+	_spTimelineVtable super;
 	void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
 			int* eventsCount, float alpha);
-	void (*dispose) (spTimeline* self);
-} _spTimelineVtable;
+} _spOwnedTimelineVtable;
+
+static void _spOwnedTimeline_apply (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time,
+		spEvent** firedEvents, int* eventsCount, float alpha, int* cursor) {
+	((const _spOwnedTimelineVtable*)self->vtable)->apply(self, skeleton, lastTime, time, firedEvents, eventsCount, alpha);
+}
 
 void _spTimeline_init (spTimeline* self, spTimelineType type, /**/
 void (*dispose) (spTimeline* self), /**/
 		void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
 				int* eventsCount, float alpha)) {
+	_spOwnedTimelineVtable* vtable = NEW(_spOwnedTimelineVtable);
+	vtable->super.apply = _spOwnedTimeline_apply;
+	vtable->super.dispose = dispose;
+	vtable->apply = apply;
+	_spTimeline_initWithVtable(self, type, SUPER(vtable));
+}
+
+void _spTimeline_initWithVtable (spTimeline* self, spTimelineType type, const _spTimelineVtable* vtable) {
 	CONST_CAST(spTimelineType, self->type) = type;
-	CONST_CAST(_spTimelineVtable*, self->vtable) = NEW(_spTimelineVtable);
-	VTABLE(spTimeline, self)->dispose = dispose;
-	VTABLE(spTimeline, self)->apply = apply;
+	CONST_CAST(const _spTimelineVtable*, self->vtable) = vtable;
 }
 
 void _spTimeline_deinit (spTimeline* self) {
-	FREE(self->vtable);
+	/* Shared vtables are not freed. */
+	if (VTABLE(spTimeline, self)->apply == _spOwnedTimeline_apply) FREE(self->vtable);
 }
 
 void spTimeline_dispose (spTimeline* self) {
@@ -105,33 +103,196 @@ void spTimeline_dispose (spTimeline* self) {
 
 void spTimeline_apply (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
 		int* eventsCount, float alpha) {
-	VTABLE(spTimeline, self)->apply(self, skeleton, lastTime, time, firedEvents, eventsCount, alpha);
+	VTABLE(spTimeline, self)->apply(self, skeleton, lastTime, time, firedEvents, eventsCount, alpha, 0);
+}
+
+void spAnimation_mixWithCursors (const spAnimation* self, spSkeleton* skeleton, float lastTime, float time, int loop,
+		spEvent** events, int* eventsCount, float alpha, int* cursors) {
+	int i, n = self->timelinesCount;
+
+	if (loop && self->duration) {
+		time = FMOD(time, self->duration);
+		lastTime = FMOD(lastTime, self->duration);
+	}
+
+	for (i = 0; i < n; ++i) {
+		const spTimeline* timeline = self->timelines[i];
+		VTABLE(spTimeline, timeline)->apply(timeline, skeleton, lastTime, time, events, eventsCount, alpha,
+				cursors ? cursors + i : 0);
+	}
+}
+
+/* Skeletons whose looped times are computed at once, so no memory is allocated. */
+#define APPLY_BATCH_SIZE 64
+
+void spAnimation_applyBatch (const spAnimation* self, spSkeleton** skeletons, const float* lastTimes, const float* times,
+		int count, int loop, spEvent*** events, int* eventsCounts, int* cursors) {
+	int i, ii, start, end, n = self->timelinesCount;
+	float loopLastTimes[APPLY_BATCH_SIZE], loopTimes[APPLY_BATCH_SIZE];
+
+	for (start = 0; start < count; start = end) {
+		const float *batchLastTimes = lastTimes + start, *batchTimes = times + start;
+		end = count - start > APPLY_BATCH_SIZE ? start + APPLY_BATCH_SIZE : count;
+		if (loop && self->duration) {
+			for (ii = start; ii < end; ++ii) {
+				loopLastTimes[ii - start] = FMOD(lastTimes[ii], self->duration);
+				loopTimes[ii - start] = FMOD(times[ii], self->duration);
+			}
+			batchLastTimes = loopLastTimes;
+			batchTimes = loopTimes;
+		}
+
+		for (i = 0; i < n; ++i) {
+			const spTimeline* timeline = self->timelines[i];
+			void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
+					int* eventsCount, float alpha, int* cursor) = VTABLE(spTimeline, timeline)->apply;
+			for (ii = start; ii < end; ++ii) {
+				apply(timeline, skeletons[ii], batchLastTimes[ii - start], batchTimes[ii - start], events ? events[ii] : 0,
+						eventsCounts ? eventsCounts + ii : 0, 1, cursors ? cursors + i * count + ii : 0);
+			}
+		}
+	}
 }
 
 /**/
 
-static const float CURVE_LINEAR = 0, CURVE_STEPPED = 1, CURVE_BEZIER = 2;
+/* frameCurves values. Bezier curves store the offset of their data in curves, added to CURVE_BEZIER. */
+static const int CURVE_LINEAR = 0, CURVE_STEPPED = 1, CURVE_BEZIER = 2;
+/* Curve data types, the first float of a curve's data. */
+static const float CURVE_DATA_SEGMENTS = 0, CURVE_DATA_LOOKUP = 1;
 static const int BEZIER_SEGMENTS = 10, BEZIER_SIZE = 10 * 2 - 1;
+static const int LOOKUP_MIN_SAMPLES = 8, LOOKUP_MAX_SAMPLES = 1024;
 
 void _spCurveTimeline_init (spCurveTimeline* self, spTimelineType type, int framesCount, /**/
 void (*dispose) (spTimeline* self), /**/
 		void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
 				int* eventsCount, float alpha)) {
 	_spTimeline_init(SUPER(self), type, dispose, apply);
-	self->curves = CALLOC(float, (framesCount - 1) * BEZIER_SIZE);
+	self->frameCurvesCount = framesCount - 1;
+	self->frameCurves = CALLOC(int, framesCount - 1);
+}
+
+void _spCurveTimeline_initWithVtable (spCurveTimeline* self, spTimelineType type, int framesCount,
+		const _spTimelineVtable* vtable) {
+	_spTimeline_initWithVtable(SUPER(self), type, vtable);
+	self->frameCurvesCount = framesCount - 1;
+	self->frameCurves = CALLOC(int, framesCount - 1);
 }
 
 void _spCurveTimeline_deinit (spCurveTimeline* self) {
 	_spTimeline_deinit(SUPER(self));
+	FREE(self->frameCurves);
 	FREE(self->curves);
 }
 
 void spCurveTimeline_setLinear (spCurveTimeline* self, int frameIndex) {
-	self->curves[frameIndex * BEZIER_SIZE] = CURVE_LINEAR;
+	self->frameCurves[frameIndex] = CURVE_LINEAR;
 }
 
 void spCurveTimeline_setStepped (spCurveTimeline* self, int frameIndex) {
-	self->curves[frameIndex * BEZIER_SIZE] = CURVE_STEPPED;
+	self->frameCurves[frameIndex] = CURVE_STEPPED;
+}
+
+static int _spCurveTimeline_getDataSize (const float* data) {
+	return data[0] == CURVE_DATA_LOOKUP ? 2 + (int)data[1] + 1 : BEZIER_SIZE;
+}
+
+/* Returns storage for size floats of curve data for the frame, reusing the frame's current data if it is large enough. When
+ * curves is full it is compacted, dropping data no frame uses anymore, before it grows. */
+static float* _spCurveTimeline_allocateData (spCurveTimeline* self, int frameIndex, int size) {
+	int i, curve = self->frameCurves[frameIndex];
+	if (curve >= CURVE_BEZIER && _spCurveTimeline_getDataSize(self->curves + curve - CURVE_BEZIER) >= size)
+		return self->curves + curve - CURVE_BEZIER;
+	self->frameCurves[frameIndex] = CURVE_LINEAR;
+	if (self->curvesCount + size > self->curvesCapacity) {
+		int used = 0, capacity;
+		float* curves;
+		for (i = 0; i < self->frameCurvesCount; ++i)
+			if (self->frameCurves[i] >= CURVE_BEZIER)
+				used += _spCurveTimeline_getDataSize(self->curves + self->frameCurves[i] - CURVE_BEZIER);
+		capacity = self->curvesCapacity;
+		if (used + size > capacity) {
+			capacity *= 2;
+			if (capacity < used + size) capacity = used + size;
+		}
+		curves = MALLOC(float, capacity);
+		self->curvesCount = 0;
+		for (i = 0; i < self->frameCurvesCount; ++i) {
+			const float* data;
+			int dataSize;
+			if (self->frameCurves[i] < CURVE_BEZIER) continue;
+			data = self->curves + self->frameCurves[i] - CURVE_BEZIER;
+			dataSize = _spCurveTimeline_getDataSize(data);
+			memcpy(curves + self->curvesCount, data, sizeof(float) * dataSize);
+			self->frameCurves[i] = CURVE_BEZIER + self->curvesCount;
+			self->curvesCount += dataSize;
+		}
+		FREE(self->curves);
+		self->curves = curves;
+		self->curvesCapacity = capacity;
+	}
+	self->frameCurves[frameIndex] = CURVE_BEZIER + self->curvesCount;
+	self->curvesCount += size;
+	return self->curves + self->curvesCount - size;
+}
+
+/* @param segments x, y, ... for the curve's segment ends, except the last at 1,1. */
+static float _spCurveTimeline_getSegmentsPercent (const float* segments, float percent) {
+	float x = 0, y;
+	int i;
+	for (i = 0; i < BEZIER_SIZE - 1; i += 2) {
+		x = segments[i];
+		if (x >= percent) {
+			float prevX, prevY;
+			if (i == 0) {
+				prevX = 0;
+				prevY = 0;
+			} else {
+				prevX = segments[i - 2];
+				prevY = segments[i - 1];
+			}
+			return prevY + (segments[i + 1] - prevY) * (percent - prevX) / (x - prevX);
+		}
+	}
+	y = segments[i - 1];
+	return y + (1 - y) * (percent - x) / (1 - x); /* Last point is 1,1. */
+}
+
+static float _spCurveTimeline_getLookupPercent (const float* samples, int n, float percent) {
+	float x = percent * n;
+	int sample = (int)x;
+	if (x <= 0) return samples[0];
+	if (sample >= n) return samples[n];
+	return samples[sample] + (samples[sample + 1] - samples[sample]) * (x - sample);
+}
+
+/* Stores the fewest uniform samples that stay within the timeline's lookupError of the segments, or the segments if none do.
+ * Both are piecewise linear and agree at the samples, so the largest difference is at a segment end. */
+static void _spCurveTimeline_setData (spCurveTimeline* self, int frameIndex, const float* segments) {
+	float samples[LOOKUP_MAX_SAMPLES + 1], *data;
+	int n, i;
+	for (n = LOOKUP_MIN_SAMPLES; self->lookupError > 0 && n <= LOOKUP_MAX_SAMPLES; n <<= 1) {
+		float error = 0;
+		for (i = 0; i <= n; ++i)
+			samples[i] = _spCurveTimeline_getSegmentsPercent(segments, (float)i / n);
+		for (i = 0; i < BEZIER_SIZE - 1; i += 2) {
+			float difference;
+			if (segments[i] < 0) continue;
+			difference = _spCurveTimeline_getLookupPercent(samples, n, segments[i]) - segments[i + 1];
+			if (difference < 0) difference = -difference;
+			if (difference > error) error = difference;
+		}
+		if (error <= self->lookupError) {
+			data = _spCurveTimeline_allocateData(self, frameIndex, 2 + n + 1);
+			data[0] = CURVE_DATA_LOOKUP;
+			data[1] = (float)n;
+			memcpy(data + 2, samples, sizeof(float) * (n + 1));
+			return;
+		}
+	}
+	data = _spCurveTimeline_allocateData(self, frameIndex, BEZIER_SIZE);
+	data[0] = CURVE_DATA_SEGMENTS;
+	memcpy(data + 1, segments, sizeof(float) * (BEZIER_SIZE - 1));
 }
 
 void spCurveTimeline_setCurve (spCurveTimeline* self, int frameIndex, float cx1, float cy1, float cx2, float cy2) {
@@ -143,12 +304,11 @@ void spCurveTimeline_setCurve (spCurveTimeline* self, int frameIndex, float cx1,
 	float dddfx = tmp2x * pre5, dddfy = tmp2y * pre5;
 	float x = dfx, y = dfy;
 
-	int i = frameIndex * BEZIER_SIZE, n = i + BEZIER_SIZE - 1;
-	self->curves[i++] = CURVE_BEZIER;
-
-	for (; i < n; i += 2) {
-		self->curves[i] = x;
-		self->curves[i + 1] = y;
+	float segments[BEZIER_SIZE - 1];
+	int i;
+	for (i = 0; i < BEZIER_SIZE - 1; i += 2) {
+		segments[i] = x;
+		segments[i + 1] = y;
 		dfx += ddfx;
 		dfy += ddfy;
 		ddfx += dddfx;
@@ -156,38 +316,50 @@ void spCurveTimeline_setCurve (spCurveTimeline* self, int frameIndex, float cx1,
 		x += dfx;
 		y += dfy;
 	}
+	_spCurveTimeline_setData(self, frameIndex, segments);
 }
 
 float spCurveTimeline_getCurvePercent (const spCurveTimeline* self, int frameIndex, float percent) {
-	float x, y;
-	int i = frameIndex * BEZIER_SIZE, start, n;
-	float type = self->curves[i];
-	if (type == CURVE_LINEAR) return percent;
-	if (type == CURVE_STEPPED) return 0;
-	i++;
-	x = 0;
-	for (start = i, n = i + BEZIER_SIZE - 1; i < n; i += 2) {
-		x = self->curves[i];
-		if (x >= percent) {
-			float prevX, prevY;
-			if (i == start) {
-				prevX = 0;
-				prevY = 0;
-			} else {
-				prevX = self->curves[i - 2];
-				prevY = self->curves[i - 1];
-			}
-			return prevY + (self->curves[i + 1] - prevY) * (percent - prevX) / (x - prevX);
-		}
+	const float* data;
+	int curve = self->frameCurves[frameIndex];
+	if (curve == CURVE_LINEAR) return percent;
+	if (curve == CURVE_STEPPED) return 0;
+	data = self->curves + curve - CURVE_BEZIER;
+	if (data[0] == CURVE_DATA_LOOKUP) return _spCurveTimeline_getLookupPercent(data + 2, (int)data[1], percent);
+	return _spCurveTimeline_getSegmentsPercent(data + 1, percent);
+}
+
+/* Sets the frame's curve to the curve of a frame of another timeline. */
+static void _spCurveTimeline_copyCurve (spCurveTimeline* self, int frameIndex, const spCurveTimeline* source, int sourceFrameIndex) {
+	int size, curve = source->frameCurves[sourceFrameIndex];
+	const float* data;
+	if (curve < CURVE_BEZIER) {
+		self->frameCurves[frameIndex] = curve;
+		return;
 	}
-	y = self->curves[i - 1];
-	return y + (1 - y) * (percent - x) / (1 - x); /* Last point is 1,1. */
+	data = source->curves + curve - CURVE_BEZIER;
+	size = _spCurveTimeline_getDataSize(data);
+	memcpy(_spCurveTimeline_allocateData(self, frameIndex, size), data, sizeof(float) * size);
 }
 
-/* @param target After the first and before the last entry. */
-static int binarySearch (float *values, int valuesLength, float target, int step) {
-	int low = 0, current;
-	int high = valuesLength / step - 2;
+/* Returns the index of the first frame after target, with frames step values apart.
+ * @param target After the first and before the last entry.
+ * @param cursor May be 0. Otherwise the index returned for the previous target, or 0, and is set to the result. When target
+ * moved forward a few frames from the previous one, the frames are walked from there instead of binary searching. */
+static int binarySearch (const float *values, int valuesLength, float target, int step, int* cursor) {
+	int low = 0, current, high;
+	if (cursor) {
+		int i = *cursor, n = i + step * 4;
+		/* A cursor from another timeline may not be on a frame boundary of this one, so it is only trusted when aligned. */
+		if (i >= step && i < valuesLength && i % step == 0 && values[i - step] <= target) {
+			if (n > valuesLength - step) n = valuesLength - step;
+			for (; i < n && values[i] <= target; i += step) {
+			}
+			if (values[i] > target || i == valuesLength - step) return *cursor = i;
+		}
+		return *cursor = binarySearch(values, valuesLength, target, step, 0);
+	}
+	high = valuesLength / step - 2;
 	if (high == 0) return step;
 	current = high >> 1;
 	while (1) {
@@ -201,23 +373,6 @@ static int binarySearch (float *values, int valuesLength, float target, int step
 	return 0;
 }
 
-/* @param target After the first and before the last entry. */
-static int binarySearch1 (float *values, int valuesLength, float target) {
-	int low = 0, current;
-	int high = valuesLength - 2;
-	if (high == 0) return 1;
-	current = high >> 1;
-	while (1) {
-		if (values[(current + 1)] <= target)
-			low = current + 1;
-		else
-			high = current;
-		if (low == high) return low + 1;
-		current = (low + high) >> 1;
-	}
-	return 0;
-}
-
 /*static int linearSearch (float *values, int valuesLength, float target, int step) {
  int i, last = valuesLength - step;
  for (i = 0; i <= last; i += step) {
@@ -237,11 +392,10 @@ void _spBaseTimeline_dispose (spTimeline* timeline) {
 }
 
 /* Many timelines have structure identical to struct spBaseTimeline and extend spCurveTimeline. **/
-struct spBaseTimeline* _spBaseTimeline_create (int framesCount, spTimelineType type, int frameSize, /**/
-		void (*apply) (const spTimeline* self, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-				int* eventsCount, float alpha)) {
+struct spBaseTimeline* _spBaseTimeline_create (int framesCount, spTimelineType type, int frameSize,
+		const _spTimelineVtable* vtable) {
 	struct spBaseTimeline* self = NEW(struct spBaseTimeline);
-	_spCurveTimeline_init(SUPER(self), type, framesCount, _spBaseTimeline_dispose, apply);
+	_spCurveTimeline_initWithVtable(SUPER(self), type, framesCount, vtable);
 
 	CONST_CAST(int, self->framesCount) = framesCount * frameSize;
 	CONST_CAST(float*, self->frames) = CALLOC(float, self->framesCount);
@@ -255,10 +409,10 @@ static const int ROTATE_PREV_FRAME_TIME = -2;
 static const int ROTATE_FRAME_VALUE = 1;
 
 void _spRotateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha) {
+		int* eventsCount, float alpha, int* cursor) {
 	spBone *bone;
 	int frameIndex;
-	float prevFrameValue, frameTime, percent, amount;
+	float prevFrameValue, frameTime, percent, amount, rotation;
 
 	spRotateTimeline* self = SUB_CAST(spRotateTimeline, timeline);
 
@@ -272,12 +426,14 @@ void _spRotateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton,
 			amount -= 360;
 		while (amount < -180)
 			amount += 360;
+		rotation = bone->rotation;
 		bone->rotation += amount * alpha;
+		if (bone->rotation != rotation) spBone_markDirty(bone);
 		return;
 	}
 
 	/* Interpolate between the previous frame and the current frame. */
-	frameIndex = binarySearch(self->frames, self->framesCount, time, 2);
+	frameIndex = binarySearch(self->frames, self->framesCount, time, 2, cursor);
 	prevFrameValue = self->frames[frameIndex - 1];
 	frameTime = self->frames[frameIndex];
 	percent = 1 - (time - frameTime) / (self->frames[frameIndex + ROTATE_PREV_FRAME_TIME] - frameTime);
@@ -293,11 +449,15 @@ void _spRotateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton,
 		amount -= 360;
 	while (amount < -180)
 		amount += 360;
+	rotation = bone->rotation;
 	bone->rotation += amount * alpha;
+	if (bone->rotation != rotation) spBone_markDirty(bone);
 }
 
+static const _spTimelineVtable _spRotateTimeline_vtable = {_spRotateTimeline_apply, _spBaseTimeline_dispose};
+
 spRotateTimeline* spRotateTimeline_create (int framesCount) {
-	return _spBaseTimeline_create(framesCount, SP_TIMELINE_ROTATE, 2, _spRotateTimeline_apply);
+	return _spBaseTimeline_create(framesCount, SP_TIMELINE_ROTATE, 2, &_spRotateTimeline_vtable);
 }
 
 void spRotateTimeline_setFrame (spRotateTimeline* self, int frameIndex, float time, float angle) {
@@ -313,10 +473,10 @@ static const int TRANSLATE_FRAME_X = 1;
 static const int TRANSLATE_FRAME_Y = 2;
 
 void _spTranslateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha) {
+		spEvent** firedEvents, int* eventsCount, float alpha, int* cursor) {
 	spBone *bone;
 	int frameIndex;
-	float prevFrameX, prevFrameY, frameTime, percent;
+	float prevFrameX, prevFrameY, frameTime, percent, x, y;
 
 	spTranslateTimeline* self = SUB_CAST(spTranslateTimeline, timeline);
 
@@ -324,14 +484,17 @@ void _spTranslateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleto
 
 	bone = skeleton->bones[self->boneIndex];
 
+	x = bone->x;
+	y = bone->y;
 	if (time >= self->frames[self->framesCount - 3]) { /* Time is after last frame. */
 		bone->x += (bone->data->x + self->frames[self->framesCount - 2] - bone->x) * alpha;
 		bone->y += (bone->data->y + self->frames[self->framesCount - 1] - bone->y) * alpha;
+		if (bone->x != x || bone->y != y) spBone_markDirty(bone);
 		return;
 	}
 
 	/* Interpolate between the previous frame and the current frame. */
-	frameIndex = binarySearch(self->frames, self->framesCount, time, 3);
+	frameIndex = binarySearch(self->frames, self->framesCount, time, 3, cursor);
 	prevFrameX = self->frames[frameIndex - 2];
 	prevFrameY = self->frames[frameIndex - 1];
 	frameTime = self->frames[frameIndex];
@@ -342,10 +505,13 @@ void _spTranslateTimeline_apply (const spTimeline* timeline, spSkeleton* skeleto
 			* alpha;
 	bone->y += (bone->data->y + prevFrameY + (self->frames[frameIndex + TRANSLATE_FRAME_Y] - prevFrameY) * percent - bone->y)
 			* alpha;
+	if (bone->x != x || bone->y != y) spBone_markDirty(bone);
 }
 
+static const _spTimelineVtable _spTranslateTimeline_vtable = {_spTranslateTimeline_apply, _spBaseTimeline_dispose};
+
 spTranslateTimeline* spTranslateTimeline_create (int framesCount) {
-	return _spBaseTimeline_create(framesCount, SP_TIMELINE_TRANSLATE, 3, _spTranslateTimeline_apply);
+	return _spBaseTimeline_create(framesCount, SP_TIMELINE_TRANSLATE, 3, &_spTranslateTimeline_vtable);
 }
 
 void spTranslateTimeline_setFrame (spTranslateTimeline* self, int frameIndex, float time, float x, float y) {
@@ -358,24 +524,27 @@ void spTranslateTimeline_setFrame (spTranslateTimeline* self, int frameIndex, fl
 /**/
 
 void _spScaleTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha) {
+		int* eventsCount, float alpha, int* cursor) {
 	spBone *bone;
 	int frameIndex;
-	float prevFrameX, prevFrameY, frameTime, percent;
+	float prevFrameX, prevFrameY, frameTime, percent, scaleX, scaleY;
 
 	spScaleTimeline* self = SUB_CAST(spScaleTimeline, timeline);
 
 	if (time < self->frames[0]) return; /* Time is before first frame. */
 
 	bone = skeleton->bones[self->boneIndex];
+	scaleX = bone->scaleX;
+	scaleY = bone->scaleY;
 	if (time >= self->frames[self->framesCount - 3]) { /* Time is after last frame. */
 		bone->scaleX += (bone->data->scaleX * self->frames[self->framesCount - 2] - bone->scaleX) * alpha;
 		bone->scaleY += (bone->data->scaleY * self->frames[self->framesCount - 1] - bone->scaleY) * alpha;
+		if (bone->scaleX != scaleX || bone->scaleY != scaleY) spBone_markDirty(bone);
 		return;
 	}
 
 	/* Interpolate between the previous frame and the current frame. */
-	frameIndex = binarySearch(self->frames, self->framesCount, time, 3);
+	frameIndex = binarySearch(self->frames, self->framesCount, time, 3, cursor);
 	prevFrameX = self->frames[frameIndex - 2];
 	prevFrameY = self->frames[frameIndex - 1];
 	frameTime = self->frames[frameIndex];
@@ -386,10 +555,13 @@ void _spScaleTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, f
 			- bone->scaleX) * alpha;
 	bone->scaleY += (bone->data->scaleY * (prevFrameY + (self->frames[frameIndex + TRANSLATE_FRAME_Y] - prevFrameY) * percent)
 			- bone->scaleY) * alpha;
+	if (bone->scaleX != scaleX || bone->scaleY != scaleY) spBone_markDirty(bone);
 }
 
+static const _spTimelineVtable _spScaleTimeline_vtable = {_spScaleTimeline_apply, _spBaseTimeline_dispose};
+
 spScaleTimeline* spScaleTimeline_create (int framesCount) {
-	return _spBaseTimeline_create(framesCount, SP_TIMELINE_SCALE, 3, _spScaleTimeline_apply);
+	return _spBaseTimeline_create(framesCount, SP_TIMELINE_SCALE, 3, &_spScaleTimeline_vtable);
 }
 
 void spScaleTimeline_setFrame (spScaleTimeline* self, int frameIndex, float time, float x, float y) {
@@ -405,7 +577,7 @@ static const int COLOR_FRAME_B = 3;
 static const int COLOR_FRAME_A = 4;
 
 void _spColorTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha) {
+		int* eventsCount, float alpha, int* cursor) {
 	spSlot *slot;
 	int frameIndex;
 	float prevFrameR, prevFrameG, prevFrameB, prevFrameA, percent, frameTime;
@@ -423,7 +595,7 @@ void _spColorTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, f
 		a = self->frames[i];
 	} else {
 		/* Interpolate between the previous frame and the current frame. */
-		frameIndex = binarySearch(self->frames, self->framesCount, time, 5);
+		frameIndex = binarySearch(self->frames, self->framesCount, time, 5, cursor);
 		prevFrameR = self->frames[frameIndex - 4];
 		prevFrameG = self->frames[frameIndex - 3];
 		prevFrameB = self->frames[frameIndex - 2];
@@ -451,8 +623,10 @@ void _spColorTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, f
 	}
 }
 
+static const _spTimelineVtable _spColorTimeline_vtable = {_spColorTimeline_apply, _spBaseTimeline_dispose};
+
 spColorTimeline* spColorTimeline_create (int framesCount) {
-	return (spColorTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_COLOR, 5, _spColorTimeline_apply);
+	return (spColorTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_COLOR, 5, &_spColorTimeline_vtable);
 }
 
 void spColorTimeline_setFrame (spColorTimeline* self, int frameIndex, float time, float r, float g, float b, float a) {
@@ -466,25 +640,60 @@ void spColorTimeline_setFrame (spColorTimeline* self, int frameIndex, float time
 
 /**/
 
+typedef struct {
+	spAttachmentTimeline super;
+	int revision; /* Changes when a frame is set. The skeletons' caches key on the timeline pointer and its revision. */
+} _spAttachmentTimeline;
+
+/* Not synchronized, revisions are only compared along with the timeline pointer. */
+static int lastRevision = 0;
+
+/* Returns the frame's attachment for the skeleton's skin and default skin. It is cached in the skeleton, so the skins are only
+ * searched again when the entry was evicted, the frame was set or attachments were added to either skin. */
+static spAttachment* _spAttachmentTimeline_getAttachment (const _spAttachmentTimeline* self, spSkeleton* skeleton,
+		int frameIndex) {
+	const char* attachmentName = self->super.attachmentNames[frameIndex];
+	const spSkin* skin = skeleton->skin;
+	const spSkin* defaultSkin = skeleton->data->defaultSkin;
+	int skinRevision = skin ? _spSkin_getRevision(skin) : 0;
+	int defaultSkinRevision = defaultSkin ? _spSkin_getRevision(defaultSkin) : 0;
+	_spTimelineAttachment* entry;
+
+	if (!attachmentName) return 0;
+	entry = SUB_CAST(_spSkeleton, skeleton)->timelineAttachments
+			+ (((unsigned int)self->revision * 31 + (unsigned int)frameIndex) & (TIMELINE_ATTACHMENTS_SIZE - 1));
+	if (entry->timeline != SUPER(SUPER(self)) || entry->timelineRevision != self->revision || entry->frameIndex != frameIndex
+			|| entry->skin != skin || entry->skinRevision != skinRevision || entry->defaultSkin != defaultSkin
+			|| entry->defaultSkinRevision != defaultSkinRevision) {
+		entry->timeline = SUPER(SUPER(self));
+		entry->skin = skin;
+		entry->defaultSkin = defaultSkin;
+		entry->timelineRevision = self->revision;
+		entry->frameIndex = frameIndex;
+		entry->skinRevision = skinRevision;
+		entry->defaultSkinRevision = defaultSkinRevision;
+		entry->attachment = spSkeleton_getAttachmentForSlotIndex(skeleton, self->super.slotIndex, attachmentName);
+	}
+	return entry->attachment;
+}
+
 void _spAttachmentTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha) {
+		spEvent** firedEvents, int* eventsCount, float alpha, int* cursor) {
 	int frameIndex;
-	const char* attachmentName;
 	spAttachmentTimeline* self = (spAttachmentTimeline*)timeline;
 
 	if (time < self->frames[0]) {
-		if (lastTime > time) _spAttachmentTimeline_apply(timeline, skeleton, lastTime, (float)INT_MAX, 0, 0, 0);
+		if (lastTime > time) _spAttachmentTimeline_apply(timeline, skeleton, lastTime, (float)INT_MAX, 0, 0, 0, 0);
 		return;
 	} else if (lastTime > time) /**/
 		lastTime = -1;
 
 	frameIndex = time >= self->frames[self->framesCount - 1] ?
-		self->framesCount - 1 : binarySearch1(self->frames, self->framesCount, time) - 1;
+		self->framesCount - 1 : binarySearch(self->frames, self->framesCount, time, 1, cursor) - 1;
 	if (self->frames[frameIndex] < lastTime) return;
 
-	attachmentName = self->attachmentNames[frameIndex];
 	spSlot_setAttachment(skeleton->slots[self->slotIndex],
-			attachmentName ? spSkeleton_getAttachmentForSlotIndex(skeleton, self->slotIndex, attachmentName) : 0);
+			_spAttachmentTimeline_getAttachment(SUB_CAST(_spAttachmentTimeline, self), skeleton, frameIndex));
 }
 
 void _spAttachmentTimeline_dispose (spTimeline* timeline) {
@@ -500,9 +709,12 @@ void _spAttachmentTimeline_dispose (spTimeline* timeline) {
 	FREE(self);
 }
 
+static const _spTimelineVtable _spAttachmentTimeline_vtable = {_spAttachmentTimeline_apply, _spAttachmentTimeline_dispose};
+
 spAttachmentTimeline* spAttachmentTimeline_create (int framesCount) {
-	spAttachmentTimeline* self = NEW(spAttachmentTimeline);
-	_spTimeline_init(SUPER(self), SP_TIMELINE_ATTACHMENT, _spAttachmentTimeline_dispose, _spAttachmentTimeline_apply);
+	spAttachmentTimeline* self = SUPER(NEW(_spAttachmentTimeline));
+	_spTimeline_initWithVtable(SUPER(self), SP_TIMELINE_ATTACHMENT, &_spAttachmentTimeline_vtable);
+	SUB_CAST(_spAttachmentTimeline, self)->revision = ++lastRevision;
 
 	CONST_CAST(int, self->framesCount) = framesCount;
 	CONST_CAST(float*, self->frames) = CALLOC(float, framesCount);
@@ -519,19 +731,21 @@ void spAttachmentTimeline_setFrame (spAttachmentTimeline* self, int frameIndex,
 		MALLOC_STR(self->attachmentNames[frameIndex], attachmentName);
 	else
 		self->attachmentNames[frameIndex] = 0;
+
+	SUB_CAST(_spAttachmentTimeline, self)->revision = ++lastRevision;
 }
 
 /**/
 
 /** Fires events for frames > lastTime and <= time. */
 void _spEventTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha) {
+		int* eventsCount, float alpha, int* cursor) {
 	spEventTimeline* self = (spEventTimeline*)timeline;
 	int frameIndex;
 	if (!firedEvents) return;
 
 	if (lastTime > time) { /* Fire events after last time for looped animations. */
-		_spEventTimeline_apply(timeline, skeleton, lastTime, (float)INT_MAX, firedEvents, eventsCount, alpha);
+		_spEventTimeline_apply(timeline, skeleton, lastTime, (float)INT_MAX, firedEvents, eventsCount, alpha, cursor);
 		lastTime = -1;
 	} else if (lastTime >= self->frames[self->framesCount - 1]) /* Last time is after last frame. */
 	return;
@@ -541,7 +755,7 @@ void _spEventTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, f
 		frameIndex = 0;
 	else {
 		float frame;
-		frameIndex = binarySearch1(self->frames, self->framesCount, lastTime);
+		frameIndex = binarySearch(self->frames, self->framesCount, lastTime, 1, cursor);
 		frame = self->frames[frameIndex];
 		while (frameIndex > 0) { /* Fire multiple events with the same frame. */
 			if (self->frames[frameIndex - 1] != frame) break;
@@ -567,9 +781,11 @@ void _spEventTimeline_dispose (spTimeline* timeline) {
 	FREE(self);
 }
 
+static const _spTimelineVtable _spEventTimeline_vtable = {_spEventTimeline_apply, _spEventTimeline_dispose};
+
 spEventTimeline* spEventTimeline_create (int framesCount) {
 	spEventTimeline* self = NEW(spEventTimeline);
-	_spTimeline_init(SUPER(self), SP_TIMELINE_EVENT, _spEventTimeline_dispose, _spEventTimeline_apply);
+	_spTimeline_initWithVtable(SUPER(self), SP_TIMELINE_EVENT, &_spEventTimeline_vtable);
 
 	CONST_CAST(int, self->framesCount) = framesCount;
 	CONST_CAST(float*, self->frames) = CALLOC(float, framesCount);
@@ -588,7 +804,7 @@ void spEventTimeline_setFrame (spEventTimeline* self, int frameIndex, float time
 /**/
 
 void _spDrawOrderTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha) {
+		spEvent** firedEvents, int* eventsCount, float alpha, int* cursor) {
 	int i;
 	int frameIndex;
 	const int* drawOrderToSetupIndex;
@@ -599,7 +815,7 @@ void _spDrawOrderTimeline_apply (const spTimeline* timeline, spSkeleton* skeleto
 	if (time >= self->frames[self->framesCount - 1]) /* Time is after last frame. */
 		frameIndex = self->framesCount - 1;
 	else
-		frameIndex = binarySearch1(self->frames, self->framesCount, time) - 1;
+		frameIndex = binarySearch(self->frames, self->framesCount, time, 1, cursor) - 1;
 
 	drawOrderToSetupIndex = self->drawOrders[frameIndex];
 	if (!drawOrderToSetupIndex)
@@ -623,9 +839,11 @@ void _spDrawOrderTimeline_dispose (spTimeline* timeline) {
 	FREE(self);
 }
 
+static const _spTimelineVtable _spDrawOrderTimeline_vtable = {_spDrawOrderTimeline_apply, _spDrawOrderTimeline_dispose};
+
 spDrawOrderTimeline* spDrawOrderTimeline_create (int framesCount, int slotsCount) {
 	spDrawOrderTimeline* self = NEW(spDrawOrderTimeline);
-	_spTimeline_init(SUPER(self), SP_TIMELINE_DRAWORDER, _spDrawOrderTimeline_dispose, _spDrawOrderTimeline_apply);
+	_spTimeline_initWithVtable(SUPER(self), SP_TIMELINE_DRAWORDER, &_spDrawOrderTimeline_vtable);
 
 	CONST_CAST(int, self->framesCount) = framesCount;
 	CONST_CAST(float*, self->frames) = CALLOC(float, framesCount);
@@ -649,12 +867,71 @@ void spDrawOrderTimeline_setFrame (spDrawOrderTimeline* self, int frameIndex, fl
 
 /**/
 
+static void _spFFDTimeline_setSetupVertices (const spFFDTimeline* self, float* vertices, int start, int end) {
+	if (start >= end) return;
+	if (self->setupVertices)
+		memcpy(vertices + start, self->setupVertices + start, (end - start) * sizeof(float));
+	else
+		memset(vertices + start, 0, (end - start) * sizeof(float));
+}
+
+static void _spFFDTimeline_mixSetupVertices (const spFFDTimeline* self, float* vertices, int start, int end, float alpha) {
+	int i;
+	for (i = start; i < end; ++i)
+		vertices[i] += ((self->setupVertices ? self->setupVertices[i] : 0) - vertices[i]) * alpha;
+}
+
+/* Returns the frame's value for a vertex. */
+static float _spFFDTimeline_getVertex (const spFFDTimeline* self, const int* range, int i) {
+	if (i >= range[0] && i < range[0] + range[1]) return self->vertices[range[2] + i - range[0]];
+	return self->setupVertices ? self->setupVertices[i] : 0;
+}
+
+/* Interpolates count vertices, 4 at a time using SIMD when available. */
+static void _spFFDTimeline_lerp (float* vertices, const float* prevVertices, const float* nextVertices, int count, float percent,
+		float alpha) {
+	int i = 0;
+	spFloat4 prev, next, vertex, vPercent, vAlpha;
+	SP_FLOAT4_SET1(vPercent, percent);
+	SP_FLOAT4_SET1(vAlpha, alpha);
+	if (alpha < 1) {
+		for (; i + 4 <= count; i += 4) {
+			SP_FLOAT4_LOAD(prev, prevVertices + i);
+			SP_FLOAT4_LOAD(next, nextVertices + i);
+			SP_FLOAT4_LOAD(vertex, vertices + i);
+			SP_FLOAT4_SUB(next, next, prev);
+			SP_FLOAT4_MUL(next, next, vPercent);
+			SP_FLOAT4_ADD(prev, prev, next);
+			SP_FLOAT4_SUB(prev, prev, vertex);
+			SP_FLOAT4_MUL(prev, prev, vAlpha);
+			SP_FLOAT4_ADD(vertex, vertex, prev);
+			SP_FLOAT4_STORE(vertices + i, vertex);
+		}
+		for (; i < count; ++i) {
+			float prevVertex = prevVertices[i];
+			vertices[i] += (prevVertex + (nextVertices[i] - prevVertex) * percent - vertices[i]) * alpha;
+		}
+	} else {
+		for (; i + 4 <= count; i += 4) {
+			SP_FLOAT4_LOAD(prev, prevVertices + i);
+			SP_FLOAT4_LOAD(next, nextVertices + i);
+			SP_FLOAT4_SUB(next, next, prev);
+			SP_FLOAT4_MUL(next, next, vPercent);
+			SP_FLOAT4_ADD(prev, prev, next);
+			SP_FLOAT4_STORE(vertices + i, prev);
+		}
+		for (; i < count; ++i) {
+			float prevVertex = prevVertices[i];
+			vertices[i] = prevVertex + (nextVertices[i] - prevVertex) * percent;
+		}
+	}
+}
+
 void _spFFDTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time, spEvent** firedEvents,
-		int* eventsCount, float alpha) {
-	int frameIndex, i;
+		int* eventsCount, float alpha, int* cursor) {
+	int frameIndex, i, start, end, bothStart, bothEnd;
 	float percent, frameTime;
-	const float* prevVertices;
-	const float* nextVertices;
+	const int *prevRange, *nextRange;
 	spFFDTimeline* self = (spFFDTimeline*)timeline;
 
 	spSlot *slot = skeleton->slots[self->slotIndex];
@@ -674,72 +951,143 @@ void _spFFDTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, flo
 
 	if (time >= self->frames[self->framesCount - 1]) {
 		/* Time is after last frame. */
-		const float* lastVertices = self->frameVertices[self->framesCount - 1];
+		const int* range = self->frameRanges + (self->framesCount - 1) * 3;
+		const float* lastVertices = self->vertices + range[2];
+		start = range[0];
+		end = range[0] + range[1];
 		if (alpha < 1) {
-			for (i = 0; i < self->frameVerticesCount; ++i)
-				slot->attachmentVertices[i] += (lastVertices[i] - slot->attachmentVertices[i]) * alpha;
-		} else
-			memcpy(slot->attachmentVertices, lastVertices, self->frameVerticesCount * sizeof(float));
+			_spFFDTimeline_mixSetupVertices(self, slot->attachmentVertices, 0, start, alpha);
+			for (i = start; i < end; ++i)
+				slot->attachmentVertices[i] += (lastVertices[i - start] - slot->attachmentVertices[i]) * alpha;
+			_spFFDTimeline_mixSetupVertices(self, slot->attachmentVertices, end, self->frameVerticesCount, alpha);
+		} else {
+			_spFFDTimeline_setSetupVertices(self, slot->attachmentVertices, 0, start);
+			memcpy(slot->attachmentVertices + start, lastVertices, range[1] * sizeof(float));
+			_spFFDTimeline_setSetupVertices(self, slot->attachmentVertices, end, self->frameVerticesCount);
+		}
 		return;
 	}
 
 	/* Interpolate between the previous frame and the current frame. */
-	frameIndex = binarySearch1(self->frames, self->framesCount, time);
+	frameIndex = binarySearch(self->frames, self->framesCount, time, 1, cursor);
 	frameTime = self->frames[frameIndex];
 	percent = 1 - (time - frameTime) / (self->frames[frameIndex - 1] - frameTime);
 	percent = spCurveTimeline_getCurvePercent(SUPER(self), frameIndex - 1, percent < 0 ? 0 : (percent > 1 ? 1 : percent));
 
-	prevVertices = self->frameVertices[frameIndex - 1];
-	nextVertices = self->frameVertices[frameIndex];
+	/* Outside the vertices either frame changes both frames are the setup vertices. Where both frames change vertices they are
+	 * interpolated directly, elsewhere one side is a setup vertex. */
+	prevRange = self->frameRanges + (frameIndex - 1) * 3;
+	nextRange = self->frameRanges + frameIndex * 3;
+	if (!prevRange[1]) {
+		start = nextRange[0];
+		end = start + nextRange[1];
+	} else if (!nextRange[1]) {
+		start = prevRange[0];
+		end = start + prevRange[1];
+	} else {
+		start = prevRange[0] < nextRange[0] ? prevRange[0] : nextRange[0];
+		end = prevRange[0] + prevRange[1] > nextRange[0] + nextRange[1] ? prevRange[0] + prevRange[1] : nextRange[0] + nextRange[1];
+	}
+	bothStart = prevRange[0] > nextRange[0] ? prevRange[0] : nextRange[0];
+	bothEnd = prevRange[0] + prevRange[1] < nextRange[0] + nextRange[1] ? prevRange[0] + prevRange[1] : nextRange[0] + nextRange[1];
+	if (bothStart >= bothEnd) bothStart = bothEnd = end;
 
 	if (alpha < 1) {
-		for (i = 0; i < self->frameVerticesCount; ++i) {
-			float prev = prevVertices[i];
-			slot->attachmentVertices[i] += (prev + (nextVertices[i] - prev) * percent - slot->attachmentVertices[i]) * alpha;
-		}
+		_spFFDTimeline_mixSetupVertices(self, slot->attachmentVertices, 0, start, alpha);
+		_spFFDTimeline_mixSetupVertices(self, slot->attachmentVertices, end, self->frameVerticesCount, alpha);
 	} else {
-		for (i = 0; i < self->frameVerticesCount; ++i) {
-			float prev = prevVertices[i];
-			slot->attachmentVertices[i] = prev + (nextVertices[i] - prev) * percent;
+		_spFFDTimeline_setSetupVertices(self, slot->attachmentVertices, 0, start);
+		_spFFDTimeline_setSetupVertices(self, slot->attachmentVertices, end, self->frameVerticesCount);
+	}
+	for (i = start; i < end; ++i) {
+		float prev, value;
+		if (i == bothStart) {
+			_spFFDTimeline_lerp(slot->attachmentVertices + i, self->vertices + prevRange[2] + i - prevRange[0],
+					self->vertices + nextRange[2] + i - nextRange[0], bothEnd - bothStart, percent, alpha);
+			i = bothEnd - 1;
+			continue;
 		}
+		prev = _spFFDTimeline_getVertex(self, prevRange, i);
+		value = prev + (_spFFDTimeline_getVertex(self, nextRange, i) - prev) * percent;
+		if (alpha < 1)
+			slot->attachmentVertices[i] += (value - slot->attachmentVertices[i]) * alpha;
+		else
+			slot->attachmentVertices[i] = value;
 	}
 }
 
 void _spFFDTimeline_dispose (spTimeline* timeline) {
 	spFFDTimeline* self = SUB_CAST(spFFDTimeline, timeline);
-	int i;
 
 	_spCurveTimeline_deinit(SUPER(self));
 
-	for (i = 0; i < self->framesCount; ++i)
-		FREE(self->frameVertices[i]);
-	FREE(self->frameVertices);
+	FREE(self->frameRanges);
+	FREE(self->vertices);
 	FREE(self->frames);
 	FREE(self);
 }
 
+static const _spTimelineVtable _spFFDTimeline_vtable = {_spFFDTimeline_apply, _spFFDTimeline_dispose};
+
 spFFDTimeline* spFFDTimeline_create (int framesCount, int frameVerticesCount) {
 	spFFDTimeline* self = NEW(spFFDTimeline);
-	_spCurveTimeline_init(SUPER(self), SP_TIMELINE_FFD, framesCount, _spFFDTimeline_dispose, _spFFDTimeline_apply);
+	_spCurveTimeline_initWithVtable(SUPER(self), SP_TIMELINE_FFD, framesCount, &_spFFDTimeline_vtable);
 	CONST_CAST(int, self->framesCount) = framesCount;
 	CONST_CAST(float*, self->frames) = CALLOC(float, self->framesCount);
-	CONST_CAST(float**, self->frameVertices) = CALLOC(float*, framesCount);
+	CONST_CAST(int*, self->frameRanges) = CALLOC(int, framesCount * 3);
 	CONST_CAST(int, self->frameVerticesCount) = frameVerticesCount;
 	return self;
 }
 
-void spFFDTimeline_setFrame (spFFDTimeline* self, int frameIndex, float time, float* vertices) {
+void spFFDTimeline_setFrame (spFFDTimeline* self, int frameIndex, float time, const float* vertices) {
+	int start = 0, end = 0;
+	if (vertices) {
+		end = self->frameVerticesCount;
+		if (self->setupVertices) {
+			while (start < end && vertices[start] == self->setupVertices[start])
+				start++;
+			while (end > start && vertices[end - 1] == self->setupVertices[end - 1])
+				end--;
+		} else {
+			while (start < end && vertices[start] == 0)
+				start++;
+			while (end > start && vertices[end - 1] == 0)
+				end--;
+		}
+	}
+	spFFDTimeline_setFrameRange(self, frameIndex, time, start, end - start, vertices ? vertices + start : 0);
+}
+
+void spFFDTimeline_setFrameRange (spFFDTimeline* self, int frameIndex, float time, int offset, int count, const float* vertices) {
+	int* range = self->frameRanges + frameIndex * 3;
 	self->frames[frameIndex] = time;
 
-	FREE(self->frameVertices[frameIndex]);
-	if (!vertices)
-		self->frameVertices[frameIndex] = 0;
-	else {
-		self->frameVertices[frameIndex] = MALLOC(float, self->frameVerticesCount);
-		memcpy(CONST_CAST(float*, self->frameVertices[frameIndex]), vertices, self->frameVerticesCount * sizeof(float));
+	/* Reuse the frame's storage when the count is unchanged, otherwise append to vertices. */
+	if (count != range[1]) {
+		if (self->verticesCount + count > self->verticesCapacity) {
+			int capacity = self->verticesCapacity * 2;
+			float* newVertices;
+			if (capacity < self->verticesCount + count) capacity = self->verticesCount + count;
+			newVertices = MALLOC(float, capacity);
+			if (self->vertices) memcpy(newVertices, self->vertices, self->verticesCount * sizeof(float));
+			FREE(self->vertices);
+			self->vertices = newVertices;
+			self->verticesCapacity = capacity;
+		}
+		range[2] = self->verticesCount;
+		self->verticesCount += count;
 	}
+	range[0] = count ? offset : 0;
+	range[1] = count;
+	if (count) memcpy(self->vertices + range[2], vertices, count * sizeof(float));
 }
 
+void spFFDTimeline_getFrameVertices (const spFFDTimeline* self, int frameIndex, float* vertices) {
+	const int* range = self->frameRanges + frameIndex * 3;
+	_spFFDTimeline_setSetupVertices(self, vertices, 0, range[0]);
+	memcpy(vertices + range[0], self->vertices + range[2], range[1] * sizeof(float));
+	_spFFDTimeline_setSetupVertices(self, vertices, range[0] + range[1], self->frameVerticesCount);
+}
 
 /**/
 
@@ -749,24 +1097,28 @@ static const int IKCONSTRAINT_PREV_FRAME_BEND_DIRECTION = -1;
 static const int IKCONSTRAINT_FRAME_MIX = 1;
 
 void _spIkConstraintTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha) {
-	int frameIndex;
-	float prevFrameMix, frameTime, percent, mix;
+		spEvent** firedEvents, int* eventsCount, float alpha, int* cursor) {
+	int frameIndex, oldBendDirection;
+	float prevFrameMix, frameTime, percent, mix, oldMix;
 	spIkConstraint* ikConstraint;
 	spIkConstraintTimeline* self = (spIkConstraintTimeline*)timeline;
 
 	if (time < self->frames[0]) return; /* Time is before first frame. */
 
 	ikConstraint = skeleton->ikConstraints[self->ikConstraintIndex];
+	oldMix = ikConstraint->mix;
+	oldBendDirection = ikConstraint->bendDirection;
 
 	if (time >= self->frames[self->framesCount - 3]) { /* Time is after last frame. */
 		ikConstraint->mix += (self->frames[self->framesCount - 2] - ikConstraint->mix) * alpha;
 		ikConstraint->bendDirection = (int)self->frames[self->framesCount - 1];
+		if (ikConstraint->mix != oldMix || ikConstraint->bendDirection != oldBendDirection)
+			spBone_markDirty(ikConstraint->bones[0]);
 		return;
 	}
 
 	/* Interpolate between the previous frame and the current frame. */
-	frameIndex = binarySearch(self->frames, self->framesCount, time, 3);
+	frameIndex = binarySearch(self->frames, self->framesCount, time, 3, cursor);
 	prevFrameMix = self->frames[frameIndex + IKCONSTRAINT_PREV_FRAME_MIX];
 	frameTime = self->frames[frameIndex];
 	percent = 1 - (time - frameTime) / (self->frames[frameIndex + IKCONSTRAINT_PREV_FRAME_TIME] - frameTime);
@@ -775,10 +1127,14 @@ void _spIkConstraintTimeline_apply (const spTimeline* timeline, spSkeleton* skel
 	mix = prevFrameMix + (self->frames[frameIndex + IKCONSTRAINT_FRAME_MIX] - prevFrameMix) * percent;
 	ikConstraint->mix += (mix - ikConstraint->mix) * alpha;
 	ikConstraint->bendDirection = (int)self->frames[frameIndex + IKCONSTRAINT_PREV_FRAME_BEND_DIRECTION];
+	if (ikConstraint->mix != oldMix || ikConstraint->bendDirection != oldBendDirection)
+		spBone_markDirty(ikConstraint->bones[0]);
 }
 
+static const _spTimelineVtable _spIkConstraintTimeline_vtable = {_spIkConstraintTimeline_apply, _spBaseTimeline_dispose};
+
 spIkConstraintTimeline* spIkConstraintTimeline_create (int framesCount) {
-	return (spIkConstraintTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_IKCONSTRAINT, 3, _spIkConstraintTimeline_apply);
+	return (spIkConstraintTimeline*)_spBaseTimeline_create(framesCount, SP_TIMELINE_IKCONSTRAINT, 3, &_spIkConstraintTimeline_vtable);
 }
 
 void spIkConstraintTimeline_setFrame (spIkConstraintTimeline* self, int frameIndex, float time, float mix, int bendDirection) {
@@ -791,24 +1147,31 @@ void spIkConstraintTimeline_setFrame (spIkConstraintTimeline* self, int frameInd
 /**/
 
 void _spFlipTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
-		spEvent** firedEvents, int* eventsCount, float alpha) {
-	int frameIndex;
+		spEvent** firedEvents, int* eventsCount, float alpha, int* cursor) {
+	int frameIndex, flip;
+	spBone* bone;
 	spFlipTimeline* self = (spFlipTimeline*)timeline;
 
 	if (time < self->frames[0]) {
-		if (lastTime > time) _spFlipTimeline_apply(timeline, skeleton, lastTime, (float)INT_MAX, 0, 0, 0);
+		if (lastTime > time) _spFlipTimeline_apply(timeline, skeleton, lastTime, (float)INT_MAX, 0, 0, 0, 0);
 		return;
 	} else if (lastTime > time) /**/
 		lastTime = -1;
 
 	frameIndex = (time >= self->frames[self->framesCount - 2] ?
-		self->framesCount : binarySearch(self->frames, self->framesCount, time, 2)) - 2;
+		self->framesCount : binarySearch(self->frames, self->framesCount, time, 2, cursor)) - 2;
 	if (self->frames[frameIndex] < lastTime) return;
 
-	if (self->x)
-		skeleton->bones[self->boneIndex]->flipX = (int)self->frames[frameIndex + 1];
-	else
-		skeleton->bones[self->boneIndex]->flipY = (int)self->frames[frameIndex + 1];
+	bone = skeleton->bones[self->boneIndex];
+	flip = (int)self->frames[frameIndex + 1];
+	if (self->x) {
+		if (bone->flipX == flip) return;
+		bone->flipX = flip;
+	} else {
+		if (bone->flipY == flip) return;
+		bone->flipY = flip;
+	}
+	spBone_markDirty(bone);
 }
 
 void _spFlipTimeline_dispose (spTimeline* timeline) {
@@ -818,9 +1181,11 @@ void _spFlipTimeline_dispose (spTimeline* timeline) {
 	FREE(self);
 }
 
+static const _spTimelineVtable _spFlipTimeline_vtable = {_spFlipTimeline_apply, _spFlipTimeline_dispose};
+
 spFlipTimeline* spFlipTimeline_create (int framesCount, int/*bool*/x) {
 	spFlipTimeline* self = NEW(spFlipTimeline);
-	_spTimeline_init(SUPER(self), x ? SP_TIMELINE_FLIPX : SP_TIMELINE_FLIPY, _spFlipTimeline_dispose, _spFlipTimeline_apply);
+	_spTimeline_initWithVtable(SUPER(self), x ? SP_TIMELINE_FLIPX : SP_TIMELINE_FLIPY, &_spFlipTimeline_vtable);
 	CONST_CAST(int, self->x) = x;
 	CONST_CAST(int, self->framesCount) = framesCount << 1;
 	CONST_CAST(float*, self->frames) = CALLOC(float, self->framesCount);
@@ -834,3 +1199,388 @@ void spFlipTimeline_setFrame (spFlipTimeline* self, int frameIndex, float time,
 }
 
 /**/
+
+static const int COMPRESSED_STEPS = 65535;
+
+static unsigned short _spCompressedTimeline_quantize (float value, float min, float max) {
+	float step;
+	if (max <= min) return 0;
+	step = (value - min) / (max - min) * COMPRESSED_STEPS + 0.5f;
+	if (step < 0) return 0;
+	return step > COMPRESSED_STEPS ? (unsigned short)COMPRESSED_STEPS : (unsigned short)step;
+}
+
+/* Dividing last keeps the range ends exact, eg for IK bend directions. */
+static float _spCompressedTimeline_getValue (const spCompressedTimeline* self, int frameIndex, int valueIndex) {
+	const float* range = self->ranges + valueIndex * 2;
+	return range[0] + (range[1] - range[0]) * self->values[frameIndex * self->valuesCount + valueIndex] / COMPRESSED_STEPS;
+}
+
+/* Dividing first keeps the last frame's time exact. */
+static float _spCompressedTimeline_getTime (const spCompressedTimeline* self, int frameIndex) {
+	return (float)self->times[frameIndex] / COMPRESSED_STEPS * self->lastFrameTime;
+}
+
+/* Returns the index of the first frame after time, or framesCount. */
+static int _spCompressedTimeline_search (const spCompressedTimeline* self, float time, int* cursor) {
+	int low = 0, high = self->framesCount;
+	if (cursor && *cursor > 0 && *cursor < self->framesCount && _spCompressedTimeline_getTime(self, *cursor - 1) <= time
+			&& _spCompressedTimeline_getTime(self, *cursor) > time) return *cursor;
+	while (low < high) {
+		int current = (low + high) >> 1;
+		if (_spCompressedTimeline_getTime(self, current) > time)
+			high = current;
+		else
+			low = current + 1;
+	}
+	if (cursor) *cursor = low;
+	return low;
+}
+
+/* Decompresses the frames around time into a timeline with the spBaseTimeline layout and applies it with the apply function of
+ * the original type. */
+void _spCompressedTimeline_apply (const spTimeline* timeline, spSkeleton* skeleton, float lastTime, float time,
+		spEvent** firedEvents, int* eventsCount, float alpha, int* cursor) {
+	struct spBaseTimeline frames;
+	float values[2 * 5];
+	int frameIndex, i, ii, count, frameSize;
+	spCompressedTimeline* self = SUB_CAST(spCompressedTimeline, timeline);
+
+	frameIndex = _spCompressedTimeline_search(self, time, cursor) - 1;
+	if (frameIndex > self->framesCount - 2) frameIndex = self->framesCount - 2;
+	if (frameIndex < 0) frameIndex = 0;
+	count = self->framesCount - frameIndex < 2 ? self->framesCount - frameIndex : 2;
+	frameSize = self->valuesCount + 1;
+	for (i = 0; i < count; ++i) {
+		values[i * frameSize] = _spCompressedTimeline_getTime(self, frameIndex + i);
+		for (ii = 0; ii < self->valuesCount; ++ii)
+			values[i * frameSize + 1 + ii] = _spCompressedTimeline_getValue(self, frameIndex + i, ii);
+	}
+
+	memset(&frames, 0, sizeof(frames));
+	CONST_CAST(spTimelineType, frames.super.super.type) = timeline->type;
+	frames.super.frameCurves = self->super.frameCurves + frameIndex;
+	frames.super.curves = self->super.curves;
+	CONST_CAST(int, frames.framesCount) = count * frameSize;
+	CONST_CAST(float*, frames.frames) = values;
+	frames.boneIndex = self->index;
+
+	switch (timeline->type) {
+	case SP_TIMELINE_ROTATE:
+		_spRotateTimeline_apply(&frames.super.super, skeleton, lastTime, time, firedEvents, eventsCount, alpha, 0);
+		break;
+	case SP_TIMELINE_TRANSLATE:
+		_spTranslateTimeline_apply(&frames.super.super, skeleton, lastTime, time, firedEvents, eventsCount, alpha, 0);
+		break;
+	case SP_TIMELINE_SCALE:
+		_spScaleTimeline_apply(&frames.super.super, skeleton, lastTime, time, firedEvents, eventsCount, alpha, 0);
+		break;
+	case SP_TIMELINE_COLOR:
+		_spColorTimeline_apply(&frames.super.super, skeleton, lastTime, time, firedEvents, eventsCount, alpha, 0);
+		break;
+	case SP_TIMELINE_IKCONSTRAINT:
+		_spIkConstraintTimeline_apply(&frames.super.super, skeleton, lastTime, time, firedEvents, eventsCount, alpha, 0);
+		break;
+	default:
+		break;
+	}
+}
+
+void _spCompressedTimeline_dispose (spTimeline* timeline) {
+	spCompressedTimeline* self = SUB_CAST(spCompressedTimeline, timeline);
+	_spCurveTimeline_deinit(SUPER(self));
+	FREE(self->times);
+	FREE(self->values);
+	FREE(self->ranges);
+	FREE(self);
+}
+
+static const _spTimelineVtable _spCompressedTimeline_vtable = {_spCompressedTimeline_apply, _spCompressedTimeline_dispose};
+
+/* Returns the difference between an interpolated value and a key's value, rotations are compared as angles. */
+static float _spCompressedTimeline_getError (spTimelineType type, float value, float keyValue) {
+	float difference = value - keyValue;
+	if (type == SP_TIMELINE_ROTATE) {
+		while (difference > 180)
+			difference -= 360;
+		while (difference < -180)
+			difference += 360;
+	}
+	return difference < 0 ? -difference : difference;
+}
+
+/* Returns true if the keys after start and before end can be dropped. */
+static int _spCompressedTimeline_canDrop (spTimelineType type, const spCurveTimeline* curves, const float* times,
+		const float* values, int valuesCount, int start, int end, float tolerance) {
+	int i, ii;
+	for (i = start; i < end; ++i)
+		if (curves->frameCurves[i] != CURVE_LINEAR) return 0;
+	for (i = start + 1; i < end; ++i) {
+		float percent = (times[i] - times[start]) / (times[end] - times[start]);
+		for (ii = 0; ii < valuesCount; ++ii) {
+			float startValue = values[start * valuesCount + ii], amount = values[end * valuesCount + ii] - startValue;
+			if (type == SP_TIMELINE_ROTATE) {
+				while (amount > 180)
+					amount -= 360;
+				while (amount < -180)
+					amount += 360;
+			}
+			if (_spCompressedTimeline_getError(type, startValue + amount * percent, values[i * valuesCount + ii]) > tolerance)
+				return 0;
+		}
+	}
+	return 1;
+}
+
+spCompressedTimeline* spCompressedTimeline_create (const spTimeline* timeline, float tolerance) {
+	spCompressedTimeline* self;
+	const spCurveTimeline* curves;
+	int i, ii, framesCount, valuesCount, index, keptCount, *kept;
+	float *times, *values, maxTime;
+
+	/* FFD timelines are not compressed. Their frames store only the vertices they change, a dense 16 bit frame is larger. */
+	if (timeline->vtable == &_spRotateTimeline_vtable || timeline->vtable == &_spTranslateTimeline_vtable
+			|| timeline->vtable == &_spScaleTimeline_vtable || timeline->vtable == &_spColorTimeline_vtable
+			|| timeline->vtable == &_spIkConstraintTimeline_vtable) {
+		const struct spBaseTimeline* base = SUB_CAST(struct spBaseTimeline, timeline);
+		curves = SUPER(base);
+		valuesCount = timeline->type == SP_TIMELINE_ROTATE ? 1 : (timeline->type == SP_TIMELINE_COLOR ? 4 : 2);
+		framesCount = base->framesCount / (valuesCount + 1);
+		index = base->boneIndex;
+		times = MALLOC(float, framesCount);
+		values = MALLOC(float, framesCount * valuesCount);
+		for (i = 0; i < framesCount; ++i) {
+			times[i] = base->frames[i * (valuesCount + 1)];
+			memcpy(values + i * valuesCount, base->frames + i * (valuesCount + 1) + 1, sizeof(float) * valuesCount);
+		}
+	} else
+		return 0;
+
+	/* Keep the first key, then each key that can't be dropped between the last kept key and the key after it. */
+	kept = MALLOC(int, framesCount);
+	kept[0] = 0;
+	keptCount = 1;
+	for (i = 1; i < framesCount; ++i) {
+		if (i < framesCount - 1
+				&& _spCompressedTimeline_canDrop(timeline->type, curves, times, values, valuesCount, kept[keptCount - 1], i + 1,
+						tolerance)) continue;
+		kept[keptCount++] = i;
+	}
+
+	self = NEW(spCompressedTimeline);
+	_spCurveTimeline_initWithVtable(SUPER(self), timeline->type, keptCount, &_spCompressedTimeline_vtable);
+	CONST_CAST(int, self->framesCount) = keptCount;
+	CONST_CAST(int, self->valuesCount) = valuesCount;
+	self->index = index;
+
+	maxTime = times[framesCount - 1];
+	CONST_CAST(float, self->lastFrameTime) = maxTime;
+	CONST_CAST(unsigned short*, self->times) = MALLOC(unsigned short, keptCount);
+	for (i = 0; i < keptCount; ++i)
+		self->times[i] = _spCompressedTimeline_quantize(times[kept[i]], 0, maxTime);
+
+	CONST_CAST(float*, self->ranges) = MALLOC(float, valuesCount * 2);
+	for (ii = 0; ii < valuesCount; ++ii) {
+		self->ranges[ii * 2] = self->ranges[ii * 2 + 1] = values[ii];
+	}
+	for (i = 0; i < keptCount; ++i) {
+		for (ii = 0; ii < valuesCount; ++ii) {
+			float value = values[kept[i] * valuesCount + ii];
+			float* range = self->ranges + ii * 2;
+			if (value < range[0]) range[0] = value;
+			if (value > range[1]) range[1] = value;
+		}
+	}
+	CONST_CAST(unsigned short*, self->values) = MALLOC(unsigned short, keptCount * valuesCount);
+	for (i = 0; i < keptCount; ++i) {
+		for (ii = 0; ii < valuesCount; ++ii) {
+			const float* range = self->ranges + ii * 2;
+			self->values[i * valuesCount + ii] = _spCompressedTimeline_quantize(values[kept[i] * valuesCount + ii], range[0],
+					range[1]);
+		}
+	}
+
+	/* A segment keeps its curve unless keys were dropped from it, then it is linear. */
+	for (i = 0; i < keptCount - 1; ++i)
+		if (kept[i + 1] == kept[i] + 1) _spCurveTimeline_copyCurve(SUPER(self), i, curves, kept[i]);
+
+	FREE(kept);
+	FREE(times);
+	FREE(values);
+	return self;
+}
+
+void spAnimation_compress (spAnimation* self, float tolerance) {
+	int i;
+	for (i = 0; i < self->timelinesCount; ++i) {
+		spCompressedTimeline* timeline = spCompressedTimeline_create(self->timelines[i], tolerance);
+		if (!timeline) continue;
+		spTimeline_dispose(self->timelines[i]);
+		self->timelines[i] = SUPER(SUPER(timeline));
+	}
+}
+
+int _spTimeline_getIndex (const spTimeline* timeline) {
+	const _spTimelineVtable* vtable = timeline->vtable;
+	if (vtable == &_spCompressedTimeline_vtable) return SUB_CAST(spCompressedTimeline, timeline)->index;
+	if (vtable == &_spRotateTimeline_vtable || vtable == &_spTranslateTimeline_vtable || vtable == &_spScaleTimeline_vtable)
+		return SUB_CAST(struct spBaseTimeline, timeline)->boneIndex;
+	if (vtable == &_spColorTimeline_vtable) return SUB_CAST(spColorTimeline, timeline)->slotIndex;
+	if (vtable == &_spAttachmentTimeline_vtable) return SUB_CAST(spAttachmentTimeline, timeline)->slotIndex;
+	if (vtable == &_spFFDTimeline_vtable) return SUB_CAST(spFFDTimeline, timeline)->slotIndex;
+	if (vtable == &_spIkConstraintTimeline_vtable) return SUB_CAST(spIkConstraintTimeline, timeline)->ikConstraintIndex;
+	if (vtable == &_spFlipTimeline_vtable) return SUB_CAST(spFlipTimeline, timeline)->boneIndex;
+	return -1;
+}
+
+float _spTimeline_getStartTime (const spTimeline* timeline) {
+	const _spTimelineVtable* vtable = timeline->vtable;
+	if (vtable == &_spCompressedTimeline_vtable) return _spCompressedTimeline_getTime(SUB_CAST(spCompressedTimeline, timeline), 0);
+	if (vtable == &_spRotateTimeline_vtable || vtable == &_spTranslateTimeline_vtable || vtable == &_spScaleTimeline_vtable)
+		return SUB_CAST(struct spBaseTimeline, timeline)->frames[0];
+	if (vtable == &_spColorTimeline_vtable) return SUB_CAST(spColorTimeline, timeline)->frames[0];
+	if (vtable == &_spAttachmentTimeline_vtable) return SUB_CAST(spAttachmentTimeline, timeline)->frames[0];
+	if (vtable == &_spEventTimeline_vtable) return SUB_CAST(spEventTimeline, timeline)->frames[0];
+	if (vtable == &_spDrawOrderTimeline_vtable) return SUB_CAST(spDrawOrderTimeline, timeline)->frames[0];
+	if (vtable == &_spFFDTimeline_vtable) return SUB_CAST(spFFDTimeline, timeline)->frames[0];
+	if (vtable == &_spIkConstraintTimeline_vtable) return SUB_CAST(spIkConstraintTimeline, timeline)->frames[0];
+	if (vtable == &_spFlipTimeline_vtable) return SUB_CAST(spFlipTimeline, timeline)->frames[0];
+	return -1;
+}
+
+/**/
+
+typedef struct {
+	spTimelineType type; /* -1 for timelines that are not of a built-in type, which are applied through their vtable. */
+	int start, count;
+} _spTimelineGroup;
+
+typedef struct {
+	spCompiledAnimation super;
+	int groupsCount;
+	_spTimelineGroup* groups;
+	const spTimeline** timelines; /* Ordered by group. */
+	int* timelineIndices; /* The index in the animation of each of timelines, for cursors. */
+	struct spBaseTimeline* baseTimelines;
+} _spCompiledAnimation;
+
+static const _spTimelineVtable* const _spTimeline_vtables[] = {
+	&_spScaleTimeline_vtable, /* SP_TIMELINE_SCALE */
+	&_spRotateTimeline_vtable, /* SP_TIMELINE_ROTATE */
+	&_spTranslateTimeline_vtable, /* SP_TIMELINE_TRANSLATE */
+	&_spColorTimeline_vtable, /* SP_TIMELINE_COLOR */
+	&_spAttachmentTimeline_vtable, /* SP_TIMELINE_ATTACHMENT */
+	&_spEventTimeline_vtable, /* SP_TIMELINE_EVENT */
+	&_spDrawOrderTimeline_vtable, /* SP_TIMELINE_DRAWORDER */
+	&_spFFDTimeline_vtable, /* SP_TIMELINE_FFD */
+	&_spIkConstraintTimeline_vtable, /* SP_TIMELINE_IKCONSTRAINT */
+	&_spFlipTimeline_vtable, /* SP_TIMELINE_FLIPX */
+	&_spFlipTimeline_vtable /* SP_TIMELINE_FLIPY */
+};
+#define TIMELINE_TYPES_COUNT ((int)(sizeof(_spTimeline_vtables) / sizeof(_spTimeline_vtables[0])))
+
+static int _spCompiledAnimation_getGroupType (const spTimeline* timeline) {
+	if ((int)timeline->type < 0 || (int)timeline->type >= TIMELINE_TYPES_COUNT) return -1;
+	return timeline->vtable == _spTimeline_vtables[timeline->type] ? (int)timeline->type : -1;
+}
+
+static int _spCompiledAnimation_hasBaseLayout (int type) {
+	return type == SP_TIMELINE_SCALE || type == SP_TIMELINE_ROTATE || type == SP_TIMELINE_TRANSLATE || type == SP_TIMELINE_COLOR
+			|| type == SP_TIMELINE_IKCONSTRAINT;
+}
+
+spCompiledAnimation* spCompiledAnimation_create (const spAnimation* animation) {
+	int i, type, n = animation->timelinesCount, timelinesCount = 0, baseTimelinesCount = 0;
+	_spCompiledAnimation* self = NEW(_spCompiledAnimation);
+	CONST_CAST(const spAnimation*, self->super.animation) = animation;
+
+	self->groups = CALLOC(_spTimelineGroup, TIMELINE_TYPES_COUNT + 1);
+	self->timelines = MALLOC(const spTimeline*, n);
+	self->timelineIndices = MALLOC(int, n);
+	for (i = 0; i < n; ++i)
+		if (_spCompiledAnimation_hasBaseLayout(_spCompiledAnimation_getGroupType(animation->timelines[i]))) baseTimelinesCount++;
+	self->baseTimelines = MALLOC(struct spBaseTimeline, baseTimelinesCount);
+	baseTimelinesCount = 0;
+
+	for (type = 0; type <= TIMELINE_TYPES_COUNT; ++type) {
+		int groupType = type < TIMELINE_TYPES_COUNT ? type : -1, start = timelinesCount;
+		for (i = 0; i < n; ++i) {
+			const spTimeline* timeline = animation->timelines[i];
+			if (_spCompiledAnimation_getGroupType(timeline) != groupType) continue;
+			if (_spCompiledAnimation_hasBaseLayout(groupType)) {
+				struct spBaseTimeline* copy = self->baseTimelines + baseTimelinesCount++;
+				memcpy(copy, timeline, sizeof(struct spBaseTimeline));
+				timeline = SUPER(SUPER(copy));
+			}
+			self->timelines[timelinesCount] = timeline;
+			self->timelineIndices[timelinesCount] = i;
+			timelinesCount++;
+		}
+		if (timelinesCount == start) continue;
+		self->groups[self->groupsCount].type = (spTimelineType)groupType;
+		self->groups[self->groupsCount].start = start;
+		self->groups[self->groupsCount].count = timelinesCount - start;
+		self->groupsCount++;
+	}
+	return SUPER(self);
+}
+
+void spCompiledAnimation_dispose (spCompiledAnimation* self) {
+	_spCompiledAnimation* internal = SUB_CAST(_spCompiledAnimation, self);
+	FREE(internal->groups);
+	FREE(internal->timelines);
+	FREE(internal->timelineIndices);
+	FREE(internal->baseTimelines);
+	FREE(self);
+}
+
+void spCompiledAnimation_mix (const spCompiledAnimation* self, spSkeleton* skeleton, float lastTime, float time, int loop,
+		spEvent** events, int* eventsCount, float alpha, int* cursors) {
+	const _spCompiledAnimation* internal = SUB_CAST(_spCompiledAnimation, self);
+	const spTimeline** timelines = internal->timelines;
+	const int* timelineIndices = internal->timelineIndices;
+	int g, i, n;
+
+	if (loop && self->animation->duration) {
+		time = FMOD(time, self->animation->duration);
+		lastTime = FMOD(lastTime, self->animation->duration);
+	}
+
+#define APPLY_GROUP(APPLY) \
+	for (; i < n; ++i) \
+		APPLY(timelines[i], skeleton, lastTime, time, events, eventsCount, alpha, cursors ? cursors + timelineIndices[i] : 0); \
+	break
+
+	for (g = 0; g < internal->groupsCount; ++g) {
+		const _spTimelineGroup* group = internal->groups + g;
+		i = group->start;
+		n = i + group->count;
+		switch ((int)group->type) {
+		case SP_TIMELINE_SCALE:
+			APPLY_GROUP(_spScaleTimeline_apply);
+		case SP_TIMELINE_ROTATE:
+			APPLY_GROUP(_spRotateTimeline_apply);
+		case SP_TIMELINE_TRANSLATE:
+			APPLY_GROUP(_spTranslateTimeline_apply);
+		case SP_TIMELINE_COLOR:
+			APPLY_GROUP(_spColorTimeline_apply);
+		case SP_TIMELINE_ATTACHMENT:
+			APPLY_GROUP(_spAttachmentTimeline_apply);
+		case SP_TIMELINE_EVENT:
+			APPLY_GROUP(_spEventTimeline_apply);
+		case SP_TIMELINE_DRAWORDER:
+			APPLY_GROUP(_spDrawOrderTimeline_apply);
+		case SP_TIMELINE_FFD:
+			APPLY_GROUP(_spFFDTimeline_apply);
+		case SP_TIMELINE_IKCONSTRAINT:
+			APPLY_GROUP(_spIkConstraintTimeline_apply);
+		case SP_TIMELINE_FLIPX:
+		case SP_TIMELINE_FLIPY:
+			APPLY_GROUP(_spFlipTimeline_apply);
+		default:
+			APPLY_GROUP(VTABLE(spTimeline, timelines[i])->apply);
+		}
+	}
+
+#undef APPLY_GROUP
+}
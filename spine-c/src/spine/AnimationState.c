@@ -34,8 +34,22 @@
 #include <string.h>
 
 spTrackEntry* _spTrackEntry_create (spAnimationState* state) {
-	spTrackEntry* self = NEW(spTrackEntry);
-	CONST_CAST(spAnimationState*, self->state) = state;
+	_spAnimationState* internal = SUB_CAST(_spAnimationState, state);
+	spTrackEntry* self = internal->entryPool;
+	if (self) {
+		_spTrackEntry* pooled = SUB_CAST(_spTrackEntry, self);
+		internal->entryPool = self->next;
+		internal->entryPoolStats.pooled--;
+		internal->entryPoolStats.reused++;
+		pooled->serial++;
+		self->next = 0;
+		/* Keep the cursors allocation, a new playback starts searching from the first frames. */
+		if (pooled->cursors) memset(pooled->cursors, 0, sizeof(int) * pooled->cursorsCount);
+	} else {
+		self = SUPER(NEW(_spTrackEntry));
+		CONST_CAST(spAnimationState*, self->state) = state;
+		internal->entryPoolStats.created++;
+	}
 	self->timeScale = 1;
 	self->lastTime = -1;
 	self->mix = 1;
@@ -43,8 +57,111 @@ spTrackEntry* _spTrackEntry_create (spAnimationState* state) {
 }
 
 void _spTrackEntry_dispose (spTrackEntry* self) {
-	if (self->previous) SUB_CAST(_spAnimationState, self->state)->disposeTrackEntry(self->previous);
-	FREE(self);
+	spAnimationState* state = self->state;
+	_spAnimationState* internal = SUB_CAST(_spAnimationState, state);
+	void* rendererObject;
+
+	if (self->previous) internal->disposeTrackEntry(self->previous);
+
+	rendererObject = internal->disposeRendererObject ? self->rendererObject : 0;
+	SUB_CAST(_spTrackEntry, self)->previousPoseState = 0;
+	/* The event timelines allocation is kept for reuse, but not the animation they were found for. */
+	SUB_CAST(_spTrackEntry, self)->eventsAnimation = 0;
+	memset(self, 0, sizeof(spTrackEntry));
+	CONST_CAST(spAnimationState*, self->state) = state;
+	self->rendererObject = rendererObject;
+
+	self->next = internal->entryPool;
+	internal->entryPool = self;
+	internal->entryPoolStats.pooled++;
+}
+
+static void _spAnimationState_disposeEntryPool (_spAnimationState* self) {
+	spTrackEntry* entry = self->entryPool;
+	while (entry) {
+		spTrackEntry* next = entry->next;
+		if (entry->rendererObject) self->disposeRendererObject(entry->rendererObject);
+		if (SUB_CAST(_spTrackEntry, entry)->previousPose) spSkeletonPose_dispose(SUB_CAST(_spTrackEntry, entry)->previousPose);
+		FREE(SUB_CAST(_spTrackEntry, entry)->cursors);
+		FREE(SUB_CAST(_spTrackEntry, entry)->eventTimelines);
+		FREE(entry);
+		entry = next;
+	}
+	self->entryPool = 0;
+	self->entryPoolStats.pooled = 0;
+}
+
+static int* _spTrackEntry_getCursors (spTrackEntry* self) {
+	_spTrackEntry* internal = SUB_CAST(_spTrackEntry, self);
+	if (internal->cursorsCount != self->animation->timelinesCount) {
+		FREE(internal->cursors);
+		internal->cursorsCount = self->animation->timelinesCount;
+		internal->cursors = CALLOC(int, internal->cursorsCount);
+	}
+	return internal->cursors;
+}
+
+/* Returns the most events the entry's animation can fire in one apply: each event key once, or twice when a loop wraps. Also
+ * finds the animation's event timelines. */
+static int _spTrackEntry_getEventsCount (spTrackEntry* self) {
+	_spTrackEntry* internal = SUB_CAST(_spTrackEntry, self);
+	if (internal->eventsAnimation != self->animation) {
+		int i;
+		internal->eventsAnimation = self->animation;
+		internal->eventsCount = 0;
+		internal->eventTimelinesCount = 0;
+		for (i = 0; i < self->animation->timelinesCount; ++i) {
+			const spTimeline* timeline = self->animation->timelines[i];
+			if (timeline->type != SP_TIMELINE_EVENT) continue;
+			internal->eventsCount += SUB_CAST(spEventTimeline, timeline)->framesCount * 2;
+			if (internal->eventTimelinesCount == internal->eventTimelinesCapacity) {
+				int* eventTimelines = MALLOC(int, internal->eventTimelinesCapacity * 2 + 4);
+				memcpy(eventTimelines, internal->eventTimelines, sizeof(int) * internal->eventTimelinesCount);
+				FREE(internal->eventTimelines);
+				internal->eventTimelines = eventTimelines;
+				internal->eventTimelinesCapacity = internal->eventTimelinesCapacity * 2 + 4;
+			}
+			internal->eventTimelines[internal->eventTimelinesCount++] = i;
+		}
+	}
+	return internal->eventsCount;
+}
+
+/* Same as spAnimation_mixWithCursors for only the animation's event timelines, without a skeleton. */
+static void _spTrackEntry_applyEvents (spTrackEntry* self, float lastTime, float time, spEvent** events, int* eventsCount) {
+	_spTrackEntry* internal = SUB_CAST(_spTrackEntry, self);
+	const spAnimation* animation = self->animation;
+	int i, *cursors = _spTrackEntry_getCursors(self);
+
+	_spTrackEntry_getEventsCount(self);
+
+	if (self->loop && animation->duration) {
+		time = FMOD(time, animation->duration);
+		lastTime = FMOD(lastTime, animation->duration);
+	}
+
+	for (i = 0; i < internal->eventTimelinesCount; ++i) {
+		int index = internal->eventTimelines[i];
+		const spTimeline* timeline = animation->timelines[index];
+		VTABLE(spTimeline, timeline)->apply(timeline, 0, lastTime, time, events, eventsCount, 1, cursors + index);
+	}
+}
+
+/* Saves the pose after the previous entry's animation was applied at time. The pose is kept with the entry in the pool. */
+static void _spTrackEntry_savePreviousPose (spTrackEntry* self, spSkeleton* skeleton, float time) {
+	_spTrackEntry* internal = SUB_CAST(_spTrackEntry, self);
+	spSkeletonPose* pose = internal->previousPose;
+	if (pose && (pose->bonesCount != skeleton->bonesCount || pose->slotsCount != skeleton->slotsCount
+			|| pose->ikConstraintsCount != skeleton->ikConstraintsCount)) {
+		spSkeletonPose_dispose(pose);
+		pose = 0;
+	}
+	if (!pose) internal->previousPose = pose = spSkeletonPose_create(skeleton);
+	spSkeleton_savePose(skeleton, pose);
+	/* Restoring right after saving changes nothing and checks the animation can be restored. */
+	internal->previousPoseTime = time;
+	internal->previousPoseState = spSkeleton_restoreAnimationPose(skeleton, pose, self->previous->animation, time,
+			self->previous->loop) ? 1 : -1;
 }
 
 /**/
@@ -60,7 +177,8 @@ void _spAnimationState_disposeTrackEntry (spTrackEntry* entry) {
 spAnimationState* spAnimationState_create (spAnimationStateData* data) {
 	_spAnimationState* internal = NEW(_spAnimationState);
 	spAnimationState* self = SUPER(internal);
-	internal->events = MALLOC(spEvent*, 64);
+	internal->eventsCapacity = 64;
+	internal->events = MALLOC(spEvent*, internal->eventsCapacity);
 	self->timeScale = 1;
 	CONST_CAST(spAnimationStateData*, self->data) = data;
 	internal->createTrackEntry = _spAnimationState_createTrackEntry;
@@ -81,14 +199,58 @@ void spAnimationState_dispose (spAnimationState* self) {
 	int i;
 	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
 	FREE(internal->events);
+	FREE(internal->queue);
 	for (i = 0; i < self->tracksCount; ++i)
 		_spAnimationState_disposeAllEntries(self, self->tracks[i]);
+	_spAnimationState_disposeEntryPool(internal);
 	FREE(self->tracks);
 	FREE(self);
 }
 
 void _spAnimationState_setCurrent (spAnimationState* self, int index, spTrackEntry* entry);
 
+static void _spAnimationState_ensureEventsCapacity (_spAnimationState* self, int capacity) {
+	if (self->eventsCapacity >= capacity) return;
+	while (self->eventsCapacity < capacity)
+		self->eventsCapacity *= 2;
+	FREE(self->events);
+	self->events = MALLOC(spEvent*, self->eventsCapacity);
+}
+
+static void _spAnimationState_queueEvents (_spAnimationState* self, int trackIndex, int eventsCount) {
+	int i;
+	if (self->queueCount + eventsCount > self->queueCapacity) {
+		int capacity = self->queueCapacity ? self->queueCapacity : 64;
+		spTrackEvent* queue;
+		while (capacity < self->queueCount + eventsCount)
+			capacity *= 2;
+		/* Unwrap the queued events to the start of the new buffer. */
+		queue = MALLOC(spTrackEvent, capacity);
+		for (i = 0; i < self->queueCount; ++i)
+			queue[i] = self->queue[(self->queueStart + i) % self->queueCapacity];
+		FREE(self->queue);
+		self->queue = queue;
+		self->queueCapacity = capacity;
+		self->queueStart = 0;
+	}
+	for (i = 0; i < eventsCount; ++i) {
+		spTrackEvent* queued = self->queue + (self->queueStart + self->queueCount) % self->queueCapacity;
+		queued->trackIndex = trackIndex;
+		queued->event = self->events[i];
+		self->queueCount++;
+	}
+}
+
+int spAnimationState_drainEvents (spAnimationState* self, spTrackEvent* events, int capacity) {
+	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
+	int i, count = internal->queueCount < capacity ? internal->queueCount : capacity;
+	for (i = 0; i < count; ++i)
+		events[i] = internal->queue[(internal->queueStart + i) % internal->queueCapacity];
+	internal->queueCount -= count;
+	internal->queueStart = internal->queueCount ? (internal->queueStart + count) % internal->queueCapacity : 0;
+	return count;
+}
+
 void spAnimationState_update (spAnimationState* self, float delta) {
 	int i;
 	float previousDelta;
@@ -114,61 +276,88 @@ void spAnimationState_update (spAnimationState* self, float delta) {
 	}
 }
 
-void spAnimationState_apply (spAnimationState* self, spSkeleton* skeleton) {
+/* Returns true if a listener replaced the track's entry. A disposed entry stays in the pool, so current can be read even if the
+ * same memory was reused for the track's new entry, which has a different serial. */
+static int/*bool*/_spAnimationState_changed (const spAnimationState* self, int trackIndex, spTrackEntry* current, int serial) {
+	return self->tracks[trackIndex] != current || SUB_CAST(_spTrackEntry, current)->serial != serial;
+}
+
+/* @param skeleton 0 to only evaluate the event timelines. */
+static void _spAnimationState_apply (spAnimationState* self, spSkeleton* skeleton) {
 	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
 
 	int i, ii;
 	int eventsCount;
 	int entryChanged;
+	int serial;
 	float time;
 	spTrackEntry* previous;
 	for (i = 0; i < self->tracksCount; ++i) {
 		spTrackEntry* current = self->tracks[i];
 		if (!current) continue;
+		serial = SUB_CAST(_spTrackEntry, current)->serial;
 
 		eventsCount = 0;
+		_spAnimationState_ensureEventsCapacity(internal, _spTrackEntry_getEventsCount(current));
 
 		time = current->time;
 		if (!current->loop && time > current->endTime) time = current->endTime;
 
 		previous = current->previous;
-		if (!previous) {
-			if (current->mix == 1) {
-				spAnimation_apply(current->animation, skeleton, current->lastTime, time,
-					current->loop, internal->events, &eventsCount);
-			} else {
-				spAnimation_mix(current->animation, skeleton, current->lastTime, time,
-					current->loop, internal->events, &eventsCount, current->mix);
+		if (!skeleton) {
+			/* Without poses the previous entry is only kept until the mix would have finished. */
+			if (previous && current->mixTime / current->mixDuration * current->mix >= 1) {
+				internal->disposeTrackEntry(current->previous);
+				current->previous = 0;
+				SUB_CAST(_spTrackEntry, current)->previousPoseState = 0;
 			}
+			_spTrackEntry_applyEvents(current, current->lastTime, time, internal->events, &eventsCount);
+		} else if (!previous) {
+			spAnimation_mixWithCursors(current->animation, skeleton, current->lastTime, time,
+				current->loop, internal->events, &eventsCount, current->mix, _spTrackEntry_getCursors(current));
 		} else {
 			float alpha = current->mixTime / current->mixDuration * current->mix;
-
-			float previousTime = previous->time;
-			if (!previous->loop && previousTime > previous->endTime) previousTime = previous->endTime;
-			spAnimation_apply(previous->animation, skeleton, previousTime, previousTime, previous->loop, 0, 0);
+			_spTrackEntry* currentInternal = SUB_CAST(_spTrackEntry, current);
+
+			if (currentInternal->previousPoseState == 1)
+				spSkeleton_restoreAnimationPose(skeleton, currentInternal->previousPose, previous->animation,
+						currentInternal->previousPoseTime, previous->loop);
+			else {
+				float previousTime = previous->time;
+				if (!previous->loop && previousTime > previous->endTime) previousTime = previous->endTime;
+				spAnimation_mixWithCursors(previous->animation, skeleton, previousTime, previousTime, previous->loop, 0, 0, 1,
+					_spTrackEntry_getCursors(previous));
+				if (self->freezeMixes && !currentInternal->previousPoseState)
+					_spTrackEntry_savePreviousPose(current, skeleton, previousTime);
+			}
 
 			if (alpha >= 1) {
 				alpha = 1;
 				internal->disposeTrackEntry(current->previous);
 				current->previous = 0;
+				currentInternal->previousPoseState = 0;
 			}
-			spAnimation_mix(current->animation, skeleton, current->lastTime, time,
-				current->loop, internal->events, &eventsCount, alpha);
+			spAnimation_mixWithCursors(current->animation, skeleton, current->lastTime, time,
+				current->loop, internal->events, &eventsCount, alpha, _spTrackEntry_getCursors(current));
 		}
 
 		entryChanged = 0;
+		if (self->deferEvents) {
+			_spAnimationState_queueEvents(internal, i, eventsCount);
+			eventsCount = 0;
+		}
 		for (ii = 0; ii < eventsCount; ++ii) {
 			spEvent* event = internal->events[ii];
 			if (current->listener) {
 				current->listener(self, i, SP_ANIMATION_EVENT, event, 0);
-				if (self->tracks[i] != current) {
+				if (_spAnimationState_changed(self, i, current, serial)) {
 					entryChanged = 1;
 					break;
 				}
 			}
 			if (self->listener) {
 				self->listener(self, i, SP_ANIMATION_EVENT, event, 0);
-				if (self->tracks[i] != current) {
+				if (_spAnimationState_changed(self, i, current, serial)) {
 					entryChanged = 1;
 					break;
 				}
@@ -182,11 +371,11 @@ void spAnimationState_apply (spAnimationState* self, spSkeleton* skeleton) {
 			int count = (int)(time / current->endTime);
 			if (current->listener) {
 				current->listener(self, i, SP_ANIMATION_COMPLETE, 0, count);
-				if (self->tracks[i] != current) continue;
+				if (_spAnimationState_changed(self, i, current, serial)) continue;
 			}
 			if (self->listener) {
 				self->listener(self, i, SP_ANIMATION_COMPLETE, 0, count);
-				if (self->tracks[i] != current) continue;
+				if (_spAnimationState_changed(self, i, current, serial)) continue;
 			}
 		}
 
@@ -194,6 +383,15 @@ void spAnimationState_apply (spAnimationState* self, spSkeleton* skeleton) {
 	}
 }
 
+void spAnimationState_apply (spAnimationState* self, spSkeleton* skeleton) {
+	_spAnimationState_apply(self, skeleton);
+}
+
+void spAnimationState_updateEventsOnly (spAnimationState* self, float delta) {
+	spAnimationState_update(self, delta);
+	_spAnimationState_apply(self, 0);
+}
+
 void spAnimationState_clearTracks (spAnimationState* self) {
 	int i;
 	for (i = 0; i < self->tracksCount; ++i)
@@ -321,3 +519,62 @@ spTrackEntry* spAnimationState_getCurrent (spAnimationState* self, int trackInde
 	if (trackIndex >= self->tracksCount) return 0;
 	return self->tracks[trackIndex];
 }
+
+void spAnimationState_getTrackEntryPoolStats (const spAnimationState* self, spTrackEntryPoolStats* stats) {
+	*stats = SUB_CAST(_spAnimationState, self)->entryPoolStats;
+}
+
+spAnimationStateTimes* spAnimationStateTimes_create (int tracksCapacity) {
+	spAnimationStateTimes* self = NEW(spAnimationStateTimes);
+	CONST_CAST(int, self->tracksCapacity) = tracksCapacity;
+	CONST_CAST(spTrackTimes*, self->tracks) = CALLOC(spTrackTimes, tracksCapacity);
+	return self;
+}
+
+void spAnimationStateTimes_dispose (spAnimationStateTimes* self) {
+	FREE(self->tracks);
+	FREE(self);
+}
+
+int spAnimationState_saveTimes (const spAnimationState* self, spAnimationStateTimes* times) {
+	int i;
+	if (self->tracksCount > times->tracksCapacity) return 0;
+	times->tracksCount = self->tracksCount;
+	for (i = 0; i < self->tracksCount; ++i) {
+		spTrackEntry* entry = self->tracks[i];
+		spTrackTimes* track = times->tracks + i;
+		track->entry = entry;
+		if (!entry) continue;
+		track->entrySerial = SUB_CAST(_spTrackEntry, entry)->serial;
+		track->previous = entry->previous;
+		if (entry->previous) track->previousSerial = SUB_CAST(_spTrackEntry, entry->previous)->serial;
+		track->time = entry->time;
+		track->lastTime = entry->lastTime;
+		track->mixTime = entry->mixTime;
+		if (entry->previous) track->previousTime = entry->previous->time;
+	}
+	return 1;
+}
+
+int spAnimationState_restoreTimes (spAnimationState* self, const spAnimationStateTimes* times) {
+	int i;
+	if (self->tracksCount != times->tracksCount) return 0;
+	for (i = 0; i < self->tracksCount; ++i) {
+		spTrackEntry* entry = self->tracks[i];
+		const spTrackTimes* track = times->tracks + i;
+		if (entry != track->entry) return 0;
+		if (!entry) continue;
+		if (SUB_CAST(_spTrackEntry, entry)->serial != track->entrySerial || entry->previous != track->previous) return 0;
+		if (entry->previous && SUB_CAST(_spTrackEntry, entry->previous)->serial != track->previousSerial) return 0;
+	}
+	for (i = 0; i < self->tracksCount; ++i) {
+		spTrackEntry* entry = self->tracks[i];
+		const spTrackTimes* track = times->tracks + i;
+		if (!entry) continue;
+		entry->time = track->time;
+		entry->lastTime = track->lastTime;
+		entry->mixTime = track->mixTime;
+		if (entry->previous) entry->previous->time = track->previousTime;
+	}
+	return 1;
+}
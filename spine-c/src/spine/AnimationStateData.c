@@ -32,41 +32,54 @@
 #include <spine/AnimationStateData.h>
 #include <spine/extension.h>
 
-typedef struct _ToEntry _ToEntry;
-struct _ToEntry {
-	spAnimation* animation;
+/* Open addressing hash table of mix durations keyed by the from and to animations, at most half full. */
+typedef struct {
+	const spAnimation* from;
+	const spAnimation* to; /* 0 for an empty slot. */
 	float duration;
-	_ToEntry* next;
-};
-
-_ToEntry* _ToEntry_create (spAnimation* to, float duration) {
-	_ToEntry* self = NEW(_ToEntry);
-	self->animation = to;
-	self->duration = duration;
-	return self;
+} _MixEntry;
+
+typedef struct {
+	int capacity; /* Power of two. */
+	int count;
+	_MixEntry* entries;
+} _MixTable;
+
+static int _MixTable_getIndex (const _MixTable* self, const spAnimation* from, const spAnimation* to) {
+	size_t hash = ((size_t)from >> 3) * 31 + ((size_t)to >> 3);
+	int mask = self->capacity - 1, index;
+	hash ^= hash >> 16;
+	hash *= 0x45d9f3b;
+	hash ^= hash >> 16;
+	index = (int)(hash & mask);
+	while (self->entries[index].to && (self->entries[index].from != from || self->entries[index].to != to))
+		index = (index + 1) & mask;
+	return index;
 }
 
-void _ToEntry_dispose (_ToEntry* self) {
-	FREE(self);
+static void _MixTable_ensureCapacity (_MixTable* self, int count) {
+	_MixEntry* entries = self->entries;
+	int i, capacity = self->capacity;
+	if (count * 2 <= self->capacity) return;
+	self->capacity = 16;
+	while (self->capacity < count * 2)
+		self->capacity *= 2;
+	self->entries = CALLOC(_MixEntry, self->capacity);
+	for (i = 0; i < capacity; ++i)
+		if (entries[i].to) self->entries[_MixTable_getIndex(self, entries[i].from, entries[i].to)] = entries[i];
+	FREE(entries);
 }
 
-/**/
-
-typedef struct _FromEntry _FromEntry;
-struct _FromEntry {
-	spAnimation* animation;
-	_ToEntry* toEntries;
-	_FromEntry* next;
-};
-
-_FromEntry* _FromEntry_create (spAnimation* from) {
-	_FromEntry* self = NEW(_FromEntry);
-	self->animation = from;
-	return self;
-}
-
-void _FromEntry_dispose (_FromEntry* self) {
-	FREE(self);
+static void _MixTable_set (_MixTable* self, const spAnimation* from, const spAnimation* to, float duration) {
+	_MixEntry* entry;
+	_MixTable_ensureCapacity(self, self->count + 1);
+	entry = self->entries + _MixTable_getIndex(self, from, to);
+	if (!entry->to) {
+		entry->from = from;
+		entry->to = to;
+		self->count++;
+	}
+	entry->duration = duration;
 }
 
 /**/
@@ -74,27 +87,14 @@ void _FromEntry_dispose (_FromEntry* self) {
 spAnimationStateData* spAnimationStateData_create (spSkeletonData* skeletonData) {
 	spAnimationStateData* self = NEW(spAnimationStateData);
 	CONST_CAST(spSkeletonData*, self->skeletonData) = skeletonData;
+	CONST_CAST(_MixTable*, self->entries) = NEW(_MixTable);
 	return self;
 }
 
 void spAnimationStateData_dispose (spAnimationStateData* self) {
-	_ToEntry* toEntry;
-	_ToEntry* nextToEntry;
-	_FromEntry* nextFromEntry;
-
-	_FromEntry* fromEntry = (_FromEntry*)self->entries;
-	while (fromEntry) {
-		toEntry = fromEntry->toEntries;
-		while (toEntry) {
-			nextToEntry = toEntry->next;
-			_ToEntry_dispose(toEntry);
-			toEntry = nextToEntry;
-		}
-		nextFromEntry = fromEntry->next;
-		_FromEntry_dispose(fromEntry);
-		fromEntry = nextFromEntry;
-	}
-
+	_MixTable* mixes = (_MixTable*)self->entries;
+	FREE(mixes->entries);
+	FREE(mixes);
 	FREE(self);
 }
 
@@ -108,45 +108,31 @@ void spAnimationStateData_setMixByName (spAnimationStateData* self, const char*
 }
 
 void spAnimationStateData_setMix (spAnimationStateData* self, spAnimation* from, spAnimation* to, float duration) {
-	/* Find existing FromEntry. */
-	_ToEntry* toEntry;
-	_FromEntry* fromEntry = (_FromEntry*)self->entries;
-	while (fromEntry) {
-		if (fromEntry->animation == from) {
-			/* Find existing ToEntry. */
-			toEntry = fromEntry->toEntries;
-			while (toEntry) {
-				if (toEntry->animation == to) {
-					toEntry->duration = duration;
-					return;
-				}
-				toEntry = toEntry->next;
-			}
-			break; /* Add new ToEntry to the existing FromEntry. */
-		}
-		fromEntry = fromEntry->next;
-	}
-	if (!fromEntry) {
-		fromEntry = _FromEntry_create(from);
-		fromEntry->next = (_FromEntry*)self->entries;
-		CONST_CAST(_FromEntry*, self->entries) = fromEntry;
-	}
-	toEntry = _ToEntry_create(to, duration);
-	toEntry->next = fromEntry->toEntries;
-	fromEntry->toEntries = toEntry;
+	_MixTable_set((_MixTable*)self->entries, from, to, duration);
+}
+
+void spAnimationStateData_setMixesByName (spAnimationStateData* self, const char** fromNames, const char** toNames,
+		const float* durations, int count) {
+	int i;
+	_MixTable* mixes = (_MixTable*)self->entries;
+	_MixTable_ensureCapacity(mixes, mixes->count + count);
+	for (i = 0; i < count; ++i)
+		spAnimationStateData_setMixByName(self, fromNames[i], toNames[i], durations[i]);
+}
+
+void spAnimationStateData_setMixes (spAnimationStateData* self, spAnimation** from, spAnimation** to, const float* durations,
+		int count) {
+	int i;
+	_MixTable* mixes = (_MixTable*)self->entries;
+	_MixTable_ensureCapacity(mixes, mixes->count + count);
+	for (i = 0; i < count; ++i)
+		_MixTable_set(mixes, from[i], to[i], durations[i]);
 }
 
 float spAnimationStateData_getMix (spAnimationStateData* self, spAnimation* from, spAnimation* to) {
-	_FromEntry* fromEntry = (_FromEntry*)self->entries;
-	while (fromEntry) {
-		if (fromEntry->animation == from) {
-			_ToEntry* toEntry = fromEntry->toEntries;
-			while (toEntry) {
-				if (toEntry->animation == to) return toEntry->duration;
-				toEntry = toEntry->next;
-			}
-		}
-		fromEntry = fromEntry->next;
-	}
-	return self->defaultMix;
+	const _MixTable* mixes = (const _MixTable*)self->entries;
+	const _MixEntry* entry;
+	if (!mixes->count || !to) return self->defaultMix;
+	entry = mixes->entries + _MixTable_getIndex(mixes, from, to);
+	return entry->to ? entry->duration : self->defaultMix;
 }
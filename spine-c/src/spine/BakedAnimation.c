@@ -0,0 +1,241 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/BakedAnimation.h>
+#include <spine/SkeletonPose.h>
+#include <spine/extension.h>
+
+static int _spBakedAnimation_getBoneSize (spBakedSpace space) {
+	return space == SP_BAKED_WORLD ? 6 : 7;
+}
+
+/* The last frame is at the duration, which may not be a multiple of the frame time. */
+static float _spBakedAnimation_getFrameTime (const spBakedAnimation* self, int frame) {
+	float time = frame / self->frameRate;
+	return time < self->animation->duration ? time : self->animation->duration;
+}
+
+/* Poses the skeleton from its setup pose with the live animation. */
+static void _spBakedAnimation_applyLive (const spBakedAnimation* self, spSkeleton* skeleton, float time) {
+	spSkeleton_setToSetupPose(skeleton);
+	spAnimation_apply(self->animation, skeleton, -1, time, 0, 0, 0);
+	spSkeleton_updateWorldTransform(skeleton);
+}
+
+static void _spBakedAnimation_bakeFrame (spBakedAnimation* self, spSkeleton* skeleton, int frame) {
+	int i;
+	float* bones = self->bones + frame * self->bonesCount * _spBakedAnimation_getBoneSize(self->space);
+	float* ikConstraints = self->ikConstraints + frame * self->ikConstraintsCount * 2;
+	float* slots = self->slots + frame * self->slotsCount * 4;
+	spAttachment** attachments = self->attachments + frame * self->slotsCount;
+
+	for (i = 0; i < self->bonesCount; ++i) {
+		const spBone* bone = skeleton->bones[i];
+		if (self->space == SP_BAKED_WORLD) {
+			*bones++ = bone->m00;
+			*bones++ = bone->m01;
+			*bones++ = bone->worldX;
+			*bones++ = bone->m10;
+			*bones++ = bone->m11;
+			*bones++ = bone->worldY;
+		} else {
+			*bones++ = bone->x;
+			*bones++ = bone->y;
+			*bones++ = bone->rotation;
+			*bones++ = bone->scaleX;
+			*bones++ = bone->scaleY;
+			*bones++ = (float)bone->flipX;
+			*bones++ = (float)bone->flipY;
+		}
+	}
+	if (self->space == SP_BAKED_LOCAL) {
+		for (i = 0; i < self->ikConstraintsCount; ++i) {
+			*ikConstraints++ = skeleton->ikConstraints[i]->mix;
+			*ikConstraints++ = (float)skeleton->ikConstraints[i]->bendDirection;
+		}
+	}
+	for (i = 0; i < self->slotsCount; ++i) {
+		const spSlot* slot = skeleton->slots[i];
+		*slots++ = slot->r;
+		*slots++ = slot->g;
+		*slots++ = slot->b;
+		*slots++ = slot->a;
+		attachments[i] = slot->attachment;
+	}
+}
+
+spBakedAnimation* spBakedAnimation_create (spSkeleton* skeleton, const spAnimation* animation, float frameRate,
+		spBakedSpace space) {
+	int i, ii, framesCount;
+	float error = 0, *worldPositions;
+	spBakedAnimation* self;
+	spSkeletonPose* pose;
+
+	if (frameRate <= 0) return 0;
+	self = NEW(spBakedAnimation);
+	pose = spSkeletonPose_create(skeleton);
+	spSkeleton_savePose(skeleton, pose);
+
+	framesCount = (int)(animation->duration * frameRate);
+	if (framesCount < animation->duration * frameRate) framesCount++;
+	framesCount++; /* The last frame is at the duration. */
+	CONST_CAST(const spAnimation*, self->animation) = animation;
+	CONST_CAST(spBakedSpace, self->space) = space;
+	CONST_CAST(float, self->frameRate) = frameRate;
+	CONST_CAST(int, self->framesCount) = framesCount;
+	CONST_CAST(int, self->bonesCount) = skeleton->bonesCount;
+	CONST_CAST(int, self->slotsCount) = skeleton->slotsCount;
+	CONST_CAST(int, self->ikConstraintsCount) = space == SP_BAKED_LOCAL ? skeleton->ikConstraintsCount : 0;
+	CONST_CAST(float*, self->bones) = MALLOC(float, framesCount * self->bonesCount * _spBakedAnimation_getBoneSize(space));
+	CONST_CAST(float*, self->ikConstraints) = MALLOC(float, framesCount * self->ikConstraintsCount * 2);
+	CONST_CAST(float*, self->slots) = MALLOC(float, framesCount * self->slotsCount * 4);
+	CONST_CAST(spAttachment**, self->attachments) = MALLOC(spAttachment*, framesCount * self->slotsCount);
+	for (i = 0; i < animation->timelinesCount; ++i) {
+		spTimelineType type = animation->timelines[i]->type;
+		if (type == SP_TIMELINE_DRAWORDER || type == SP_TIMELINE_FFD) CONST_CAST(int, self->unbaked) = 1;
+	}
+
+	for (i = 0; i < framesCount; ++i) {
+		_spBakedAnimation_applyLive(self, skeleton, _spBakedAnimation_getFrameTime(self, i));
+		_spBakedAnimation_bakeFrame(self, skeleton, i);
+	}
+
+	/* Between frames is where the baked animation differs most from the live animation. */
+	worldPositions = MALLOC(float, skeleton->bonesCount * 2);
+	for (i = 0; i < framesCount - 1; ++i) {
+		float time = (_spBakedAnimation_getFrameTime(self, i) + _spBakedAnimation_getFrameTime(self, i + 1)) / 2;
+		_spBakedAnimation_applyLive(self, skeleton, time);
+		for (ii = 0; ii < skeleton->bonesCount; ++ii) {
+			worldPositions[ii * 2] = skeleton->bones[ii]->worldX;
+			worldPositions[ii * 2 + 1] = skeleton->bones[ii]->worldY;
+		}
+		spSkeleton_setToSetupPose(skeleton);
+		spBakedAnimation_apply(self, skeleton, time, 0);
+		if (space == SP_BAKED_LOCAL) spSkeleton_updateWorldTransform(skeleton);
+		for (ii = 0; ii < skeleton->bonesCount; ++ii) {
+			float dx = skeleton->bones[ii]->worldX - worldPositions[ii * 2];
+			float dy = skeleton->bones[ii]->worldY - worldPositions[ii * 2 + 1];
+			float distance = SQRT(dx * dx + dy * dy);
+			if (distance > error) error = distance;
+		}
+	}
+	FREE(worldPositions);
+	CONST_CAST(float, self->error) = error;
+
+	spSkeleton_restorePose(skeleton, pose);
+	spSkeletonPose_dispose(pose);
+	return self;
+}
+
+void spBakedAnimation_dispose (spBakedAnimation* self) {
+	FREE(self->bones);
+	FREE(self->ikConstraints);
+	FREE(self->slots);
+	FREE(self->attachments);
+	FREE(self);
+}
+
+void spBakedAnimation_apply (const spBakedAnimation* self, spSkeleton* skeleton, float time, int/*bool*/loop) {
+	int i, frame, boneSize = _spBakedAnimation_getBoneSize(self->space);
+	float percent, duration = self->animation->duration;
+	const float *bones, *nextBones, *slots, *nextSlots;
+	spAttachment** attachments;
+
+	if (loop && duration) time = FMOD(time, duration);
+	if (time < 0) time = 0;
+	if (time >= duration) {
+		frame = self->framesCount - 1;
+		percent = 0;
+	} else {
+		/* The last segment can be shorter than the frame time. */
+		float frameTime, nextFrameTime;
+		frame = (int)(time * self->frameRate);
+		if (frame > self->framesCount - 2) frame = self->framesCount - 2;
+		frameTime = _spBakedAnimation_getFrameTime(self, frame);
+		nextFrameTime = _spBakedAnimation_getFrameTime(self, frame + 1);
+		percent = (time - frameTime) / (nextFrameTime - frameTime);
+		if (percent < 0) percent = 0;
+		if (percent > 1) percent = 1;
+	}
+
+	/* The last frame is interpolated with itself. */
+	bones = self->bones + frame * self->bonesCount * boneSize;
+	nextBones = frame < self->framesCount - 1 ? bones + self->bonesCount * boneSize : bones;
+	if (self->space == SP_BAKED_WORLD) {
+		for (i = 0; i < self->bonesCount; ++i, bones += 6, nextBones += 6) {
+			spBone* bone = skeleton->bones[i];
+			CONST_CAST(float, bone->m00) = bones[0] + (nextBones[0] - bones[0]) * percent;
+			CONST_CAST(float, bone->m01) = bones[1] + (nextBones[1] - bones[1]) * percent;
+			CONST_CAST(float, bone->worldX) = bones[2] + (nextBones[2] - bones[2]) * percent;
+			CONST_CAST(float, bone->m10) = bones[3] + (nextBones[3] - bones[3]) * percent;
+			CONST_CAST(float, bone->m11) = bones[4] + (nextBones[4] - bones[4]) * percent;
+			CONST_CAST(float, bone->worldY) = bones[5] + (nextBones[5] - bones[5]) * percent;
+		}
+		/* The world transforms no longer match the local transforms. */
+		SUB_CAST(_spSkeleton, skeleton)->worldValid = 0;
+	} else {
+		const float* ikConstraints = self->ikConstraints + frame * self->ikConstraintsCount * 2;
+		const float* nextIkConstraints = frame < self->framesCount - 1 ? ikConstraints + self->ikConstraintsCount * 2 : ikConstraints;
+		for (i = 0; i < self->bonesCount; ++i, bones += 7, nextBones += 7) {
+			spBone* bone = skeleton->bones[i];
+			float amount = nextBones[2] - bones[2];
+			while (amount > 180)
+				amount -= 360;
+			while (amount < -180)
+				amount += 360;
+			bone->x = bones[0] + (nextBones[0] - bones[0]) * percent;
+			bone->y = bones[1] + (nextBones[1] - bones[1]) * percent;
+			bone->rotation = bones[2] + amount * percent;
+			bone->scaleX = bones[3] + (nextBones[3] - bones[3]) * percent;
+			bone->scaleY = bones[4] + (nextBones[4] - bones[4]) * percent;
+			bone->flipX = (int)bones[5];
+			bone->flipY = (int)bones[6];
+			spBone_markDirty(bone);
+		}
+		for (i = 0; i < self->ikConstraintsCount; ++i, ikConstraints += 2, nextIkConstraints += 2) {
+			spIkConstraint* ikConstraint = skeleton->ikConstraints[i];
+			ikConstraint->mix = ikConstraints[0] + (nextIkConstraints[0] - ikConstraints[0]) * percent;
+			ikConstraint->bendDirection = (int)ikConstraints[1];
+		}
+	}
+
+	slots = self->slots + frame * self->slotsCount * 4;
+	nextSlots = frame < self->framesCount - 1 ? slots + self->slotsCount * 4 : slots;
+	attachments = self->attachments + frame * self->slotsCount;
+	for (i = 0; i < self->slotsCount; ++i, slots += 4, nextSlots += 4) {
+		spSlot* slot = skeleton->slots[i];
+		slot->r = slots[0] + (nextSlots[0] - slots[0]) * percent;
+		slot->g = slots[1] + (nextSlots[1] - slots[1]) * percent;
+		slot->b = slots[2] + (nextSlots[2] - slots[2]) * percent;
+		slot->a = slots[3] + (nextSlots[3] - slots[3]) * percent;
+		if (slot->attachment != attachments[i]) spSlot_setAttachment(slot, attachments[i]);
+	}
+}
@@ -31,6 +31,7 @@
 
 #include <spine/Bone.h>
 #include <spine/extension.h>
+#include "Simd.h"
 
 static int yDown;
 
@@ -42,12 +43,28 @@ int spBone_isYDown () {
 	return yDown;
 }
 
-spBone* spBone_create (spBoneData* data, spSkeleton* skeleton, spBone* parent) {
-	spBone* self = NEW(spBone);
+void _spBone_init (spBone* self, spBoneData* data, spSkeleton* skeleton, spBone* parent) {
 	CONST_CAST(spBoneData*, self->data) = data;
 	CONST_CAST(spSkeleton*, self->skeleton) = skeleton;
 	CONST_CAST(spBone*, self->parent) = parent;
+	SUB_CAST(_spBone, self)->trigRotation = 0;
+	SIN_COS(0, SUB_CAST(_spBone, self)->sine, SUB_CAST(_spBone, self)->cosine);
 	spBone_setToSetupPose(self);
+}
+
+void _spBone_cosSin (spBone* self, float worldRotation, float* cosine, float* sine) {
+	_spBone* internal = SUB_CAST(_spBone, self);
+	if (worldRotation != internal->trigRotation) {
+		internal->trigRotation = worldRotation;
+		SIN_COS(worldRotation * DEG_RAD, internal->sine, internal->cosine);
+	}
+	*cosine = internal->cosine;
+	*sine = internal->sine;
+}
+
+spBone* spBone_create (spBoneData* data, spSkeleton* skeleton, spBone* parent) {
+	spBone* self = SUPER(NEW(_spBone));
+	_spBone_init(self, data, skeleton, parent);
 	return self;
 }
 
@@ -56,7 +73,7 @@ void spBone_dispose (spBone* self) {
 }
 
 void spBone_updateWorldTransform (spBone* self) {
-	float radians, cosine, sine;
+	float cosine, sine;
 	if (self->parent) {
 		CONST_CAST(float, self->worldX) = self->x * self->parent->m00 + self->y * self->parent->m01 + self->parent->worldX;
 		CONST_CAST(float, self->worldY) = self->x * self->parent->m10 + self->y * self->parent->m11 + self->parent->worldY;
@@ -81,9 +98,7 @@ void spBone_updateWorldTransform (spBone* self) {
 		CONST_CAST(int, self->worldFlipX) = skeletonFlipX ^ self->flipX;
 		CONST_CAST(int, self->worldFlipY) = skeletonFlipY ^ self->flipY;
 	}
-	radians = self->worldRotation * DEG_RAD;
-	cosine = COS(radians);
-	sine = SIN(radians);
+	_spBone_cosSin(self, self->worldRotation, &cosine, &sine);
 	if (self->worldFlipX) {
 		CONST_CAST(float, self->m00) = -cosine * self->worldScaleX;
 		CONST_CAST(float, self->m01) = sine * self->worldScaleY;
@@ -100,7 +115,146 @@ void spBone_updateWorldTransform (spBone* self) {
 	}
 }
 
+void _spBone_updateWorldTransforms (spBone** bones, int count) {
+	float x[4], y[4], rotation[4], scaleX[4], scaleY[4];
+	float parentM00[4], parentM01[4], parentWorldX[4], parentM10[4], parentM11[4], parentWorldY[4];
+	float parentWorldRotation[4], parentWorldScaleX[4], parentWorldScaleY[4];
+	float signX[4], negSignX[4], signY[4], cosine[4], sine[4];
+	float m00[4], m01[4], worldX[4], m10[4], m11[4], worldY[4], worldRotation[4], worldScaleX[4], worldScaleY[4];
+	int worldFlipX[4], worldFlipY[4];
+	spFloat4 vx, vy, vWorldX, vWorldY, vWorldRotation, vWorldScaleX, vWorldScaleY;
+	spFloat4 vCos, vSin, vSignX, vNegSignX, vSignY, a, b;
+	spBoneData* data = bones[0]->data;
+	int i, parent = bones[0]->parent != 0;
+
+	/* Unused lanes repeat the last bone, their results are discarded. */
+	for (i = 0; i < 4; ++i) {
+		spBone* bone = bones[i < count ? i : count - 1];
+		x[i] = bone->x;
+		y[i] = bone->y;
+		rotation[i] = bone->rotationIK;
+		scaleX[i] = bone->scaleX;
+		scaleY[i] = bone->scaleY;
+		if (parent) {
+			spBone* p = bone->parent;
+			parentM00[i] = p->m00;
+			parentM01[i] = p->m01;
+			parentWorldX[i] = p->worldX;
+			parentM10[i] = p->m10;
+			parentM11[i] = p->m11;
+			parentWorldY[i] = p->worldY;
+			parentWorldRotation[i] = p->worldRotation;
+			parentWorldScaleX[i] = p->worldScaleX;
+			parentWorldScaleY[i] = p->worldScaleY;
+			worldFlipX[i] = p->worldFlipX ^ bone->flipX;
+			worldFlipY[i] = p->worldFlipY ^ bone->flipY;
+		} else {
+			signX[i] = bone->skeleton->flipX ? -1.0f : 1.0f;
+			signY[i] = bone->skeleton->flipY != yDown ? -1.0f : 1.0f;
+			worldFlipX[i] = bone->skeleton->flipX ^ bone->flipX;
+			worldFlipY[i] = bone->skeleton->flipY ^ bone->flipY;
+		}
+	}
+
+	SP_FLOAT4_LOAD(vx, x);
+	SP_FLOAT4_LOAD(vy, y);
+	SP_FLOAT4_LOAD(vWorldRotation, rotation);
+	SP_FLOAT4_LOAD(vWorldScaleX, scaleX);
+	SP_FLOAT4_LOAD(vWorldScaleY, scaleY);
+	if (parent) {
+		SP_FLOAT4_LOAD(a, parentM00);
+		SP_FLOAT4_MUL(vWorldX, vx, a);
+		SP_FLOAT4_LOAD(a, parentM01);
+		SP_FLOAT4_MUL(b, vy, a);
+		SP_FLOAT4_ADD(vWorldX, vWorldX, b);
+		SP_FLOAT4_LOAD(a, parentWorldX);
+		SP_FLOAT4_ADD(vWorldX, vWorldX, a);
+
+		SP_FLOAT4_LOAD(a, parentM10);
+		SP_FLOAT4_MUL(vWorldY, vx, a);
+		SP_FLOAT4_LOAD(a, parentM11);
+		SP_FLOAT4_MUL(b, vy, a);
+		SP_FLOAT4_ADD(vWorldY, vWorldY, b);
+		SP_FLOAT4_LOAD(a, parentWorldY);
+		SP_FLOAT4_ADD(vWorldY, vWorldY, a);
+
+		if (data->inheritScale) {
+			SP_FLOAT4_LOAD(a, parentWorldScaleX);
+			SP_FLOAT4_MUL(vWorldScaleX, a, vWorldScaleX);
+			SP_FLOAT4_LOAD(a, parentWorldScaleY);
+			SP_FLOAT4_MUL(vWorldScaleY, a, vWorldScaleY);
+		}
+		if (data->inheritRotation) {
+			SP_FLOAT4_LOAD(a, parentWorldRotation);
+			SP_FLOAT4_ADD(vWorldRotation, a, vWorldRotation);
+		}
+	} else {
+		/* Negation is exact, so multiplying by -1 matches the scalar path. */
+		SP_FLOAT4_LOAD(a, signX);
+		SP_FLOAT4_MUL(vWorldX, vx, a);
+		SP_FLOAT4_LOAD(a, signY);
+		SP_FLOAT4_MUL(vWorldY, vy, a);
+	}
+
+	SP_FLOAT4_STORE(worldRotation, vWorldRotation);
+	for (i = 0; i < 4; ++i) {
+		if (i < count)
+			_spBone_cosSin(bones[i], worldRotation[i], cosine + i, sine + i);
+		else {
+			cosine[i] = cosine[i - 1];
+			sine[i] = sine[i - 1];
+		}
+		signX[i] = worldFlipX[i] ? -1.0f : 1.0f;
+		negSignX[i] = -signX[i];
+		signY[i] = worldFlipY[i] != yDown ? -1.0f : 1.0f;
+	}
+	SP_FLOAT4_LOAD(vCos, cosine);
+	SP_FLOAT4_LOAD(vSin, sine);
+	SP_FLOAT4_LOAD(vSignX, signX);
+	SP_FLOAT4_LOAD(vNegSignX, negSignX);
+	SP_FLOAT4_LOAD(vSignY, signY);
+
+
+	/* m00 = +-cos * worldScaleX, m01 = -+sin * worldScaleY, m10 = +-sin * worldScaleX, m11 = +-cos * worldScaleY. */
+	SP_FLOAT4_MUL(a, vCos, vWorldScaleX);
+	SP_FLOAT4_MUL(a, a, vSignX);
+	SP_FLOAT4_STORE(m00, a);
+	SP_FLOAT4_MUL(a, vSin, vWorldScaleY);
+	SP_FLOAT4_MUL(a, a, vNegSignX);
+	SP_FLOAT4_STORE(m01, a);
+	SP_FLOAT4_MUL(a, vSin, vWorldScaleX);
+	SP_FLOAT4_MUL(a, a, vSignY);
+	SP_FLOAT4_STORE(m10, a);
+	SP_FLOAT4_MUL(a, vCos, vWorldScaleY);
+	SP_FLOAT4_MUL(a, a, vSignY);
+	SP_FLOAT4_STORE(m11, a);
+	SP_FLOAT4_STORE(worldX, vWorldX);
+	SP_FLOAT4_STORE(worldY, vWorldY);
+	SP_FLOAT4_STORE(worldScaleX, vWorldScaleX);
+	SP_FLOAT4_STORE(worldScaleY, vWorldScaleY);
+
+	for (i = 0; i < count; ++i) {
+		spBone* bone = bones[i];
+		CONST_CAST(float, bone->m00) = m00[i];
+		CONST_CAST(float, bone->m01) = m01[i];
+		CONST_CAST(float, bone->worldX) = worldX[i];
+		CONST_CAST(float, bone->m10) = m10[i];
+		CONST_CAST(float, bone->m11) = m11[i];
+		CONST_CAST(float, bone->worldY) = worldY[i];
+		CONST_CAST(float, bone->worldRotation) = worldRotation[i];
+		CONST_CAST(float, bone->worldScaleX) = worldScaleX[i];
+		CONST_CAST(float, bone->worldScaleY) = worldScaleY[i];
+		CONST_CAST(int, bone->worldFlipX) = worldFlipX[i];
+		CONST_CAST(int, bone->worldFlipY) = worldFlipY[i];
+	}
+}
+
+void spBone_markDirty (spBone* self) {
+	SUB_CAST(_spBone, self)->dirty = 1;
+}
+
 void spBone_setToSetupPose (spBone* self) {
+	SUB_CAST(_spBone, self)->dirty = 1;
 	self->x = self->data->x;
 	self->y = self->data->y;
 	self->rotation = self->data->rotation;
@@ -33,19 +33,23 @@
 #include <spine/Skeleton.h>
 #include <spine/extension.h>
 
-spIkConstraint* spIkConstraint_create (spIkConstraintData* data, const spSkeleton* skeleton) {
-	int i;
-
-	spIkConstraint* self = NEW(spIkConstraint);
+void _spIkConstraint_init (spIkConstraint* self, spIkConstraintData* data, spBone** bones, spBone* target) {
 	CONST_CAST(spIkConstraintData*, self->data) = data;
 	self->bendDirection = data->bendDirection;
 	self->mix = data->mix;
+	self->bonesCount = data->bonesCount;
+	self->bones = bones;
+	self->target = target;
+}
 
-	self->bonesCount = self->data->bonesCount;
-	self->bones = MALLOC(spBone*, self->bonesCount);
-	for (i = 0; i < self->bonesCount; ++i)
-		self->bones[i] = spSkeleton_findBone(skeleton, self->data->bones[i]->name);
-	self->target = spSkeleton_findBone(skeleton, self->data->target->name);
+spIkConstraint* spIkConstraint_create (spIkConstraintData* data, const spSkeleton* skeleton) {
+	int i;
+
+	spIkConstraint* self = NEW(spIkConstraint);
+	spBone** bones = MALLOC(spBone*, data->bonesCount);
+	for (i = 0; i < data->bonesCount; ++i)
+		bones[i] = spSkeleton_findBone(skeleton, data->bones[i]->name);
+	_spIkConstraint_init(self, data, bones, spSkeleton_findBone(skeleton, data->target->name));
 
 	return self;
 }
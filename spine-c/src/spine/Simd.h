@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SIMD_H_
+#define SPINE_SIMD_H_
+
+/* Minimal 4 lane float vectors for the runtime's batched kernels. Only lane-wise IEEE add, subtract and multiply are exposed,
+ * so every lane computes exactly what the equivalent scalar expression does, provided the compiler does not contract
+ * multiplies and adds into fused instructions, see extension.h. The operations are statements that assign their first
+ * argument. Define SPINE_NO_SIMD to use the scalar fallback. */
+
+#if !defined(SPINE_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+
+#include <xmmintrin.h>
+
+typedef __m128 spFloat4;
+#define SP_FLOAT4_LOAD(R,P) R = _mm_loadu_ps(P)
+#define SP_FLOAT4_STORE(P,V) _mm_storeu_ps(P, V)
+#define SP_FLOAT4_SET1(R,S) R = _mm_set1_ps(S)
+#define SP_FLOAT4_ADD(R,A,B) R = _mm_add_ps(A, B)
+#define SP_FLOAT4_SUB(R,A,B) R = _mm_sub_ps(A, B)
+#define SP_FLOAT4_MUL(R,A,B) R = _mm_mul_ps(A, B)
+
+#elif !defined(SPINE_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+
+#include <arm_neon.h>
+
+typedef float32x4_t spFloat4;
+#define SP_FLOAT4_LOAD(R,P) R = vld1q_f32(P)
+#define SP_FLOAT4_STORE(P,V) vst1q_f32(P, V)
+#define SP_FLOAT4_SET1(R,S) R = vdupq_n_f32(S)
+#define SP_FLOAT4_ADD(R,A,B) R = vaddq_f32(A, B)
+#define SP_FLOAT4_SUB(R,A,B) R = vsubq_f32(A, B)
+#define SP_FLOAT4_MUL(R,A,B) R = vmulq_f32(A, B)
+
+#else
+
+typedef struct spFloat4 {
+	float v[4];
+} spFloat4;
+#define SP_FLOAT4_LOAD(R,P) (R.v[0] = (P)[0], R.v[1] = (P)[1], R.v[2] = (P)[2], R.v[3] = (P)[3])
+#define SP_FLOAT4_STORE(P,V) ((P)[0] = V.v[0], (P)[1] = V.v[1], (P)[2] = V.v[2], (P)[3] = V.v[3])
+#define SP_FLOAT4_SET1(R,S) (R.v[0] = R.v[1] = R.v[2] = R.v[3] = (S))
+#define SP_FLOAT4_ADD(R,A,B) (R.v[0] = A.v[0] + B.v[0], R.v[1] = A.v[1] + B.v[1], R.v[2] = A.v[2] + B.v[2], R.v[3] = A.v[3] + B.v[3])
+#define SP_FLOAT4_SUB(R,A,B) (R.v[0] = A.v[0] - B.v[0], R.v[1] = A.v[1] - B.v[1], R.v[2] = A.v[2] - B.v[2], R.v[3] = A.v[3] - B.v[3])
+#define SP_FLOAT4_MUL(R,A,B) (R.v[0] = A.v[0] * B.v[0], R.v[1] = A.v[1] * B.v[1], R.v[2] = A.v[2] * B.v[2], R.v[3] = A.v[3] * B.v[3])
+
+#endif
+
+#endif /* SPINE_SIMD_H_ */
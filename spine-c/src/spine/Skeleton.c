@@ -30,60 +30,68 @@
  *****************************************************************************/
 
 #include <spine/Skeleton.h>
+#include <stddef.h>
 #include <string.h>
 #include <spine/extension.h>
 
-typedef struct {
-	spSkeleton super;
-
-	int boneCacheCount;
-	int* boneCacheCounts;
-	spBone*** boneCache;
-} _spSkeleton;
+/* Rounds a size up so the next object in the skeleton's block is aligned. */
+static size_t _spSkeleton_align (size_t size) {
+	return (size + 7) & ~(size_t)7;
+}
 
 spSkeleton* spSkeleton_create (spSkeletonData* data) {
-	int i, ii;
-
-	_spSkeleton* internal = NEW(_spSkeleton);
-	spSkeleton* self = SUPER(internal);
+	int i, ii, ikBonesCount = 0;
+	size_t size;
+	char* block;
+	_spSkeleton* internal;
+	spSkeleton* self;
+	_spBone* bones;
+	_spSlot* slots;
+	spIkConstraint* ikConstraints;
+	spBone** ikBones;
+
+	/* The skeleton, its bones, slots, IK constraints and their arrays are allocated in a single block. */
+	for (i = 0; i < data->ikConstraintsCount; ++i)
+		ikBonesCount += data->ikConstraints[i]->bonesCount;
+	size = _spSkeleton_align(sizeof(_spSkeleton));
+	size += _spSkeleton_align(sizeof(spBone*) * data->bonesCount) + _spSkeleton_align(sizeof(_spBone) * data->bonesCount);
+	size += _spSkeleton_align(sizeof(spSlot*) * data->slotsCount) * 2 + _spSkeleton_align(sizeof(_spSlot) * data->slotsCount);
+	size += _spSkeleton_align(sizeof(spIkConstraint*) * data->ikConstraintsCount);
+	size += _spSkeleton_align(sizeof(spIkConstraint) * data->ikConstraintsCount);
+	size += _spSkeleton_align(sizeof(spBone*) * ikBonesCount);
+	size += _spSkeleton_align(1); /* Keeps empty arrays at the end inside the block. */
+
+	block = CALLOC(char, size);
+	internal = (_spSkeleton*)block;
+	internal->size = size;
+	self = SUPER(internal);
 	CONST_CAST(spSkeletonData*, self->data) = data;
+	block += _spSkeleton_align(sizeof(_spSkeleton));
 
-	self->bonesCount = self->data->bonesCount;
-	self->bones = MALLOC(spBone*, self->bonesCount);
-
+	self->bonesCount = data->bonesCount;
+	self->bones = (spBone**)block;
+	block += _spSkeleton_align(sizeof(spBone*) * data->bonesCount);
+	bones = (_spBone*)block;
+	block += _spSkeleton_align(sizeof(_spBone) * data->bonesCount);
 	for (i = 0; i < self->bonesCount; ++i) {
-		spBoneData* boneData = self->data->bones[i];
-		spBone* parent = 0;
-		if (boneData->parent) {
-			/* Find parent bone. */
-			for (ii = 0; ii < self->bonesCount; ++ii) {
-				if (data->bones[ii] == boneData->parent) {
-					parent = self->bones[ii];
-					break;
-				}
-			}
-		}
-		self->bones[i] = spBone_create(boneData, self, parent);
+		spBoneData* boneData = data->bones[i];
+		self->bones[i] = &bones[i].super;
+		_spBone_init(self->bones[i], boneData, self, boneData->parent ? self->bones[boneData->parent->index] : 0);
 	}
 	CONST_CAST(spBone*, self->root) = self->bones[0];
 
 	self->slotsCount = data->slotsCount;
-	self->slots = MALLOC(spSlot*, self->slotsCount);
+	self->slots = (spSlot**)block;
+	block += _spSkeleton_align(sizeof(spSlot*) * data->slotsCount);
+	self->drawOrder = (spSlot**)block;
+	block += _spSkeleton_align(sizeof(spSlot*) * data->slotsCount);
+	slots = (_spSlot*)block;
+	block += _spSkeleton_align(sizeof(_spSlot) * data->slotsCount);
 	for (i = 0; i < self->slotsCount; ++i) {
 		spSlotData *slotData = data->slots[i];
-
-		/* Find bone for the slotData's boneData. */
-		spBone* bone = 0;
-		for (ii = 0; ii < self->bonesCount; ++ii) {
-			if (data->bones[ii] == slotData->boneData) {
-				bone = self->bones[ii];
-				break;
-			}
-		}
-		self->slots[i] = spSlot_create(slotData, bone);
+		self->slots[i] = &slots[i].super;
+		_spSlot_init(self->slots[i], slotData, self->bones[slotData->boneData->index]);
 	}
-
-	self->drawOrder = MALLOC(spSlot*, self->slotsCount);
 	memcpy(self->drawOrder, self->slots, sizeof(spSlot*) * self->slotsCount);
 
 	self->r = 1;
@@ -92,125 +100,435 @@ spSkeleton* spSkeleton_create (spSkeletonData* data) {
 	self->a = 1;
 
 	self->ikConstraintsCount = data->ikConstraintsCount;
-	self->ikConstraints = MALLOC(spIkConstraint*, self->ikConstraintsCount);
-	for (i = 0; i < self->data->ikConstraintsCount; ++i)
-		self->ikConstraints[i] = spIkConstraint_create(self->data->ikConstraints[i], self);
+	self->ikConstraints = (spIkConstraint**)block;
+	block += _spSkeleton_align(sizeof(spIkConstraint*) * data->ikConstraintsCount);
+	ikConstraints = (spIkConstraint*)block;
+	block += _spSkeleton_align(sizeof(spIkConstraint) * data->ikConstraintsCount);
+	ikBones = (spBone**)block;
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		spIkConstraintData* ikConstraintData = data->ikConstraints[i];
+		for (ii = 0; ii < ikConstraintData->bonesCount; ++ii)
+			ikBones[ii] = self->bones[ikConstraintData->bones[ii]->index];
+		self->ikConstraints[i] = &ikConstraints[i];
+		_spIkConstraint_init(self->ikConstraints[i], ikConstraintData, ikBones, self->bones[ikConstraintData->target->index]);
+		ikBones += ikConstraintData->bonesCount;
+	}
 
 	spSkeleton_updateCache(self);
 
 	return self;
 }
 
+/* Returns true if the memory is part of the skeleton's block, false if it was set by the user. */
+static int/*bool*/_spSkeleton_owns (const spSkeleton* self, const void* memory) {
+	const char* block = (const char*)self;
+	return (const char*)memory >= block && (const char*)memory < block + SUB_CAST(_spSkeleton, self)->size;
+}
+
 void spSkeleton_dispose (spSkeleton* self) {
 	int i;
 	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
 
-	for (i = 0; i < internal->boneCacheCount; ++i)
-		FREE(internal->boneCache[i]);
-	FREE(internal->boneCache);
-	FREE(internal->boneCacheCounts);
+	spUpdateOrder_dispose(internal->ownUpdateOrder);
+	FREE(internal->ikChanged);
+	FREE(internal->setupPose);
 
 	for (i = 0; i < self->bonesCount; ++i)
-		spBone_dispose(self->bones[i]);
-	FREE(self->bones);
+		if (!_spSkeleton_owns(self, self->bones[i])) spBone_dispose(self->bones[i]);
+	if (!_spSkeleton_owns(self, self->bones)) FREE(self->bones);
 
-	for (i = 0; i < self->slotsCount; ++i)
-		spSlot_dispose(self->slots[i]);
-	FREE(self->slots);
+	for (i = 0; i < self->slotsCount; ++i) {
+		if (_spSkeleton_owns(self, self->slots[i]))
+			FREE(self->slots[i]->attachmentVertices);
+		else
+			spSlot_dispose(self->slots[i]);
+	}
+	if (!_spSkeleton_owns(self, self->slots)) FREE(self->slots);
+	if (!_spSkeleton_owns(self, self->drawOrder)) FREE(self->drawOrder);
 
-	for (i = 0; i < self->ikConstraintsCount; ++i)
-		spIkConstraint_dispose(self->ikConstraints[i]);
-	FREE(self->ikConstraints);
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		if (!_spSkeleton_owns(self, self->ikConstraints[i]))
+			spIkConstraint_dispose(self->ikConstraints[i]);
+		else if (!_spSkeleton_owns(self, self->ikConstraints[i]->bones))
+			FREE(self->ikConstraints[i]->bones);
+	}
+	if (!_spSkeleton_owns(self, self->ikConstraints)) FREE(self->ikConstraints);
 
-	FREE(self->drawOrder);
 	FREE(self);
 }
 
-void spSkeleton_updateCache (const spSkeleton* self) {
+/* Returns true if every bone, slot, IK constraint and array is still the one created in the skeleton's block. */
+static int/*bool*/_spSkeleton_ownsAll (const spSkeleton* self) {
+	int i;
+	if (!_spSkeleton_owns(self, self->bones) || !_spSkeleton_owns(self, self->slots)
+			|| !_spSkeleton_owns(self, self->drawOrder) || !_spSkeleton_owns(self, self->ikConstraints)) return 0;
+	for (i = 0; i < self->bonesCount; ++i)
+		if (!_spSkeleton_owns(self, self->bones[i])) return 0;
+	for (i = 0; i < self->slotsCount; ++i)
+		if (!_spSkeleton_owns(self, self->slots[i])) return 0;
+	for (i = 0; i < self->ikConstraintsCount; ++i)
+		if (!_spSkeleton_owns(self, self->ikConstraints[i]) || !_spSkeleton_owns(self, self->ikConstraints[i]->bones)) return 0;
+	return 1;
+}
+
+/* Moves a pointer into the prototype's block to the same offset in the clone's block. */
+#define RELOCATE(TYPE,VALUE) CONST_CAST(TYPE, VALUE) = (TYPE)((char*)(VALUE) + offset)
+
+spSkeleton* spSkeleton_clone (const spSkeleton* self) {
 	int i, ii;
+	ptrdiff_t offset;
+	spSkeleton* clone;
 	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
 
-	for (i = 0; i < internal->boneCacheCount; ++i)
-		FREE(internal->boneCache[i]);
-	FREE(internal->boneCache);
-	FREE(internal->boneCacheCounts);
+	if (!_spSkeleton_ownsAll(self)) return 0;
 
-	internal->boneCacheCount = self->ikConstraintsCount + 1;
-	internal->boneCache = MALLOC(spBone**, internal->boneCacheCount);
-	internal->boneCacheCounts = CALLOC(int, internal->boneCacheCount);
+	clone = (spSkeleton*)MALLOC(char, internal->size);
+	memcpy(clone, self, internal->size);
+	offset = (char*)clone - (char*)self;
 
-	/* Compute array sizes. */
-	for (i = 0; i < self->bonesCount; ++i) {
-		spBone* current = self->bones[i];
-		do {
-			for (ii = 0; ii < self->ikConstraintsCount; ++ii) {
-				spIkConstraint* ikConstraint = self->ikConstraints[ii];
-				spBone* parent = ikConstraint->bones[0];
-				spBone* child = ikConstraint->bones[ikConstraint->bonesCount - 1];
-				while (1) {
-					if (current == child) {
-						internal->boneCacheCounts[ii]++;
-						internal->boneCacheCounts[ii + 1]++;
-						goto outer1;
-					}
-					if (child == parent) break;
-					child = child->parent;
-				}
-			}
-			current = current->parent;
-		} while (current);
-		internal->boneCacheCounts[0]++;
-		outer1: {}
+	RELOCATE(spBone**, clone->bones);
+	RELOCATE(spBone*, clone->root);
+	for (i = 0; i < clone->bonesCount; ++i) {
+		spBone* bone;
+		RELOCATE(spBone*, clone->bones[i]);
+		bone = clone->bones[i];
+		CONST_CAST(spSkeleton*, bone->skeleton) = clone;
+		if (bone->parent) RELOCATE(spBone*, bone->parent);
+	}
+
+	RELOCATE(spSlot**, clone->slots);
+	RELOCATE(spSlot**, clone->drawOrder);
+	for (i = 0; i < clone->slotsCount; ++i) {
+		spSlot* slot;
+		RELOCATE(spSlot*, clone->slots[i]);
+		RELOCATE(spSlot*, clone->drawOrder[i]);
+		slot = clone->slots[i];
+		RELOCATE(spBone*, slot->bone);
+		if (slot->attachmentVertices) {
+			float* vertices = MALLOC(float, slot->attachmentVerticesCapacity);
+			memcpy(vertices, slot->attachmentVertices, sizeof(float) * slot->attachmentVerticesCount);
+			slot->attachmentVertices = vertices;
+		}
 	}
 
-	for (i = 0; i < internal->boneCacheCount; ++i)
-		internal->boneCache[i] = MALLOC(spBone*, internal->boneCacheCounts[i]);
-	memset(internal->boneCacheCounts, 0, internal->boneCacheCount * sizeof(int));
+	RELOCATE(spIkConstraint**, clone->ikConstraints);
+	for (i = 0; i < clone->ikConstraintsCount; ++i) {
+		spIkConstraint* ikConstraint;
+		RELOCATE(spIkConstraint*, clone->ikConstraints[i]);
+		ikConstraint = clone->ikConstraints[i];
+		RELOCATE(spBone**, ikConstraint->bones);
+		for (ii = 0; ii < ikConstraint->bonesCount; ++ii)
+			RELOCATE(spBone*, ikConstraint->bones[ii]);
+		RELOCATE(spBone*, ikConstraint->target);
+	}
+
+	internal = SUB_CAST(_spSkeleton, clone);
+	internal->ownUpdateOrder = 0;
+	internal->ikChanged = 0;
+	internal->setupPose = 0;
+	spSkeleton_updateCache(clone);
+
+	return clone;
+}
+
+#undef RELOCATE
+
+void spSkeleton_updateCache (const spSkeleton* self) {
+	int i, *parents, *ikParents, *ikChildren;
+	int/*bool*/shared;
+	const spUpdateOrder* order;
+	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
+	const spSkeletonData* data = self->data;
 
-	/* Populate arrays. */
+	spUpdateOrder_dispose(internal->ownUpdateOrder);
+	internal->ownUpdateOrder = 0;
+	FREE(internal->ikChanged);
+	FREE(internal->setupPose);
+	internal->setupPose = 0;
+
+	for (i = 0; i < self->bonesCount; ++i)
+		SUB_CAST(_spBone, self->bones[i])->index = i;
+
+	/* The skeleton data's update order is used when the skeleton's bones and IK constraints match the data. */
+	shared = self->bonesCount == data->bonesCount && self->ikConstraintsCount == data->ikConstraintsCount;
+	for (i = 0; i < self->bonesCount && shared; ++i) {
+		spBone* bone = self->bones[i];
+		shared = bone->data == data->bones[i]
+				&& (bone->parent ? SUB_CAST(_spBone, bone->parent)->index : -1)
+						== (bone->data->parent ? bone->data->parent->index : -1);
+	}
+	for (i = 0; i < self->ikConstraintsCount && shared; ++i) {
+		spIkConstraint* ikConstraint = self->ikConstraints[i];
+		spIkConstraintData* ikConstraintData = data->ikConstraints[i];
+		shared = ikConstraint->bonesCount == ikConstraintData->bonesCount
+				&& ikConstraint->bones[0]->data == ikConstraintData->bones[0]
+				&& ikConstraint->bones[ikConstraint->bonesCount - 1]->data
+						== ikConstraintData->bones[ikConstraintData->bonesCount - 1];
+	}
+	if (shared)
+		order = spSkeletonData_getUpdateOrder(data);
+	else {
+		parents = MALLOC(int, self->bonesCount + self->ikConstraintsCount * 2);
+		ikParents = parents + self->bonesCount;
+		ikChildren = ikParents + self->ikConstraintsCount;
+		for (i = 0; i < self->bonesCount; ++i)
+			parents[i] = self->bones[i]->parent ? SUB_CAST(_spBone, self->bones[i]->parent)->index : -1;
+		for (i = 0; i < self->ikConstraintsCount; ++i) {
+			spIkConstraint* ikConstraint = self->ikConstraints[i];
+			ikParents[i] = SUB_CAST(_spBone, ikConstraint->bones[0])->index;
+			ikChildren[i] = SUB_CAST(_spBone, ikConstraint->bones[ikConstraint->bonesCount - 1])->index;
+		}
+		order = internal->ownUpdateOrder = _spUpdateOrder_create(self->bonesCount, parents, self->ikConstraintsCount, ikParents,
+				ikChildren);
+		FREE(parents);
+	}
+	internal->updateOrder = order;
+
+	/* Incremental updates require bones ordered parent first, each bone's final update segment to come after its parent's and
+	 * IK targets to be updated before their constraint is applied. Otherwise a full update reads values from the previous
+	 * frame, which an incremental update can't reproduce. */
+	internal->ikChanged = CALLOC(int, self->ikConstraintsCount);
+	internal->incremental = 1;
+	internal->worldValid = 0;
+	for (i = 0; i < self->bonesCount; ++i) {
+		spBone* parent = self->bones[i]->parent;
+		if (!parent) continue;
+		if (SUB_CAST(_spBone, parent)->index > i || order->ikIndices[SUB_CAST(_spBone, parent)->index] > order->ikIndices[i])
+			internal->incremental = 0;
+	}
+	for (i = 0; i < self->ikConstraintsCount; ++i)
+		if (order->ikIndices[SUB_CAST(_spBone, self->ikConstraints[i]->target)->index] > i) internal->incremental = 0;
+}
+
+/* Resets rotationIK and the incremental update state before a full update. */
+static void _spSkeleton_resetBones (const spSkeleton* self) {
+	int i;
+	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
 	for (i = 0; i < self->bonesCount; ++i) {
 		spBone* bone = self->bones[i];
-		spBone* current = bone;
-		do {
-			for (ii = 0; ii < self->ikConstraintsCount; ++ii) {
-				spIkConstraint* ikConstraint = self->ikConstraints[ii];
-				spBone* parent = ikConstraint->bones[0];
-				spBone* child = ikConstraint->bones[ikConstraint->bonesCount - 1];
-				while (1) {
-					if (current == child) {
-						internal->boneCache[ii][internal->boneCacheCounts[ii]++] = bone;
-						internal->boneCache[ii + 1][internal->boneCacheCounts[ii + 1]++] = bone;
-						goto outer2;
-					}
-					if (child == parent) break;
-					child = child->parent;
-				}
-			}
-			current = current->parent;
-		} while (current);
-		internal->boneCache[0][internal->boneCacheCounts[0]++] = bone;
-		outer2: {}
+		bone->rotationIK = bone->rotation;
+		SUB_CAST(_spBone, bone)->dirty = 0;
 	}
+	internal->worldValid = 1;
+	internal->lastFlipX = self->flipX;
+	internal->lastFlipY = self->flipY;
+	internal->lastYDown = spBone_isYDown();
 }
 
 void spSkeleton_updateWorldTransform (const spSkeleton* self) {
-	int i, ii, nn, last;
-	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
+	int i, ii, last;
+	const spUpdateOrder* order = SUB_CAST(_spSkeleton, self)->updateOrder;
 
-	for (i = 0; i < self->bonesCount; ++i)
-		self->bones[i]->rotationIK = self->bones[i]->rotation;
+	_spSkeleton_resetBones(self);
+
+	last = order->ikConstraintsCount;
+	for (i = 0, ii = 0; ; ++i) {
+		for (; ii < order->segmentEnds[i]; ++ii)
+			spBone_updateWorldTransform(self->bones[order->indices[ii]]);
+		if (i == last) break;
+		spIkConstraint_apply(self->ikConstraints[i]);
+	}
+}
+
+static void _spBone_writeMatrix (const spBone* bone, float* out) {
+	out[0] = bone->m00;
+	out[1] = bone->m01;
+	out[2] = bone->worldX;
+	out[3] = bone->m10;
+	out[4] = bone->m11;
+	out[5] = bone->worldY;
+}
 
-	i = 0;
-	last = internal->boneCacheCount - 1;
-	while (1) {
-		for (ii = 0, nn = internal->boneCacheCounts[i]; ii < nn; ++ii)
-			spBone_updateWorldTransform(internal->boneCache[i][ii]);
+void spSkeleton_writeBoneMatrices (const spSkeleton* self, float* out, int stride) {
+	int i;
+	for (i = 0; i < self->bonesCount; ++i, out += stride)
+		_spBone_writeMatrix(self->bones[i], out);
+}
+
+void spSkeleton_updateWorldTransformTo (const spSkeleton* self, float* out, int stride) {
+	int i, ii, last;
+	const spUpdateOrder* order = SUB_CAST(_spSkeleton, self)->updateOrder;
+
+	_spSkeleton_resetBones(self);
+
+	/* Bones affected by an IK constraint are updated again in the next segment, overwriting their earlier matrix. */
+	last = order->ikConstraintsCount;
+	for (i = 0, ii = 0; ; ++i) {
+		for (; ii < order->segmentEnds[i]; ++ii) {
+			int index = order->indices[ii];
+			spBone* bone = self->bones[index];
+			spBone_updateWorldTransform(bone);
+			_spBone_writeMatrix(bone, out + index * stride);
+		}
 		if (i == last) break;
 		spIkConstraint_apply(self->ikConstraints[i]);
-		i++;
 	}
 }
 
+int spSkeleton_updateWorldTransformIncremental (const spSkeleton* self) {
+	int i, ii, last, count = 0;
+	int/*bool*/rootChanged;
+	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
+	const spUpdateOrder* order = internal->updateOrder;
+
+	if (!internal->incremental || !internal->worldValid || internal->lastYDown != spBone_isYDown()) {
+		spSkeleton_updateWorldTransform(self);
+		return self->bonesCount;
+	}
+
+	/* Bones are ordered parent first, so a single pass finds the dirty subtrees. */
+	rootChanged = self->flipX != internal->lastFlipX || self->flipY != internal->lastFlipY;
+	for (i = 0; i < self->bonesCount; ++i) {
+		_spBone* bone = SUB_CAST(_spBone, self->bones[i]);
+		bone->changed = bone->dirty || (bone->super.parent ? SUB_CAST(_spBone, bone->super.parent)->changed : rootChanged);
+	}
+
+	/* An IK constraint is applied again when its bones or target changed. Then every bone in its segments changes. */
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		spIkConstraint* ikConstraint = self->ikConstraints[i];
+		int changed = SUB_CAST(_spBone, ikConstraint->target)->changed;
+		for (ii = 0; ii < ikConstraint->bonesCount && !changed; ++ii)
+			changed = SUB_CAST(_spBone, ikConstraint->bones[ii])->changed;
+		internal->ikChanged[i] = changed;
+		if (!changed) continue;
+		for (ii = 0; ii < self->bonesCount; ++ii) {
+			_spBone* bone = SUB_CAST(_spBone, self->bones[ii]);
+			if (order->ikIndices[ii] == i || (bone->super.parent && SUB_CAST(_spBone, bone->super.parent)->changed))
+				bone->changed = 1;
+		}
+	}
+
+	for (i = 0; i < self->bonesCount; ++i) {
+		_spBone* bone = SUB_CAST(_spBone, self->bones[i]);
+		bone->dirty = 0;
+		if (!bone->changed) continue;
+		bone->super.rotationIK = bone->super.rotation;
+		count++;
+	}
+	if (!count) return 0;
+
+	last = order->ikConstraintsCount;
+	for (i = 0, ii = 0; ; ++i) {
+		for (; ii < order->segmentEnds[i]; ++ii) {
+			spBone* bone = self->bones[order->indices[ii]];
+			if (SUB_CAST(_spBone, bone)->changed) spBone_updateWorldTransform(bone);
+		}
+		if (i == last) break;
+		if (internal->ikChanged[i]) spIkConstraint_apply(self->ikConstraints[i]);
+	}
+
+	internal->lastFlipX = self->flipX;
+	internal->lastFlipY = self->flipY;
+	return count;
+}
+
+static void _spSkeleton_updateWorldTransformLanes (spSkeleton** skeletons, int count) {
+	spBone* bones[4];
+	int i, ii, last, lane;
+	const spUpdateOrder* order = SUB_CAST(_spSkeleton, skeletons[0])->updateOrder;
+
+	for (lane = 0; lane < count; ++lane)
+		_spSkeleton_resetBones(skeletons[lane]);
+
+	last = order->ikConstraintsCount;
+	for (i = 0, ii = 0; ; ++i) {
+		for (; ii < order->segmentEnds[i]; ++ii) {
+			for (lane = 0; lane < count; ++lane)
+				bones[lane] = skeletons[lane]->bones[order->indices[ii]];
+			_spBone_updateWorldTransforms(bones, count);
+		}
+		if (i == last) break;
+		for (lane = 0; lane < count; ++lane)
+			spIkConstraint_apply(skeletons[lane]->ikConstraints[i]);
+	}
+}
+
+void spSkeleton_updateWorldTransformBatch (spSkeleton** skeletons, int count) {
+	int i, n;
+	for (i = 0; i < count; i += n) {
+		const spUpdateOrder* order = SUB_CAST(_spSkeleton, skeletons[i])->updateOrder;
+		for (n = 1; n < 4 && i + n < count; ++n)
+			if (SUB_CAST(_spSkeleton, skeletons[i + n])->updateOrder != order) break;
+		if (n == 1)
+			spSkeleton_updateWorldTransform(skeletons[i]);
+		else
+			_spSkeleton_updateWorldTransformLanes(skeletons + i, n);
+	}
+}
+
+typedef struct {
+	/* Same layout as the spBone fields from x to flipY, so a bone is reset with one copy. */
+	float x, y;
+	float rotation, rotationIK;
+	float scaleX, scaleY;
+	int/*bool*/flipX, flipY;
+} _spBonePose;
+
+/* Fails to compile if the spBone fields from x to flipY no longer match _spBonePose. */
+typedef char _spBonePose_matchesBone[
+		offsetof(spBone, flipY) + sizeof(int) - offsetof(spBone, x) == sizeof(_spBonePose)
+		&& offsetof(spBone, scaleX) - offsetof(spBone, x) == offsetof(_spBonePose, scaleX) ? 1 : -1];
+
+typedef struct {
+	float r, g, b, a;
+	spAttachment* attachment;
+} _spSlotPose;
+
+typedef struct _spSetupPose {
+	/* The skins used to resolve the slot attachments and their revisions then, 0 for no skin. */
+	const spSkin* skin;
+	const spSkin* defaultSkin;
+	int skinRevision, defaultRevision;
+	_spSlotPose* slots;
+	_spBonePose* bones;
+} _spSetupPose;
+
+static _spSetupPose* _spSkeleton_getSetupPose (const spSkeleton* self) {
+	int i;
+	_spSkeleton* internal = SUB_CAST(_spSkeleton, self);
+	_spSetupPose* pose = internal->setupPose;
+	const spSkin* defaultSkin = self->data->defaultSkin;
+	int skinRevision = self->skin ? _spSkin_getRevision(self->skin) : 0;
+	int defaultRevision = defaultSkin ? _spSkin_getRevision(defaultSkin) : 0;
+	if (!pose) {
+		/* Slots first, they need pointer alignment. */
+		pose = internal->setupPose = (_spSetupPose*)MALLOC(char,
+				sizeof(_spSetupPose) + sizeof(_spSlotPose) * self->slotsCount + sizeof(_spBonePose) * self->bonesCount);
+		pose->slots = (_spSlotPose*)(pose + 1);
+		pose->bones = (_spBonePose*)(pose->slots + self->slotsCount);
+		for (i = 0; i < self->bonesCount; ++i) {
+			const spBoneData* data = self->bones[i]->data;
+			_spBonePose* bone = pose->bones + i;
+			bone->x = data->x;
+			bone->y = data->y;
+			bone->rotation = data->rotation;
+			bone->rotationIK = data->rotation;
+			bone->scaleX = data->scaleX;
+			bone->scaleY = data->scaleY;
+			bone->flipX = data->flipX;
+			bone->flipY = data->flipY;
+		}
+		for (i = 0; i < self->slotsCount; ++i) {
+			const spSlotData* data = self->slots[i]->data;
+			_spSlotPose* slot = pose->slots + i;
+			slot->r = data->r;
+			slot->g = data->g;
+			slot->b = data->b;
+			slot->a = data->a;
+		}
+	} else if (pose->skin == self->skin && pose->skinRevision == skinRevision && pose->defaultSkin == defaultSkin
+			&& pose->defaultRevision == defaultRevision)
+		return pose;
+
+	pose->skin = self->skin;
+	pose->skinRevision = skinRevision;
+	pose->defaultSkin = defaultSkin;
+	pose->defaultRevision = defaultRevision;
+	for (i = 0; i < self->slotsCount; ++i)
+		pose->slots[i].attachment = _spSlot_getSetupAttachment(self->slots[i]);
+	return pose;
+}
+
 void spSkeleton_setToSetupPose (const spSkeleton* self) {
 	spSkeleton_setBonesToSetupPose(self);
 	spSkeleton_setSlotsToSetupPose(self);
@@ -218,8 +536,12 @@ void spSkeleton_setToSetupPose (const spSkeleton* self) {
 
 void spSkeleton_setBonesToSetupPose (const spSkeleton* self) {
 	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		spBone_setToSetupPose(self->bones[i]);
+	const _spBonePose* bones = _spSkeleton_getSetupPose(self)->bones;
+	for (i = 0; i < self->bonesCount; ++i) {
+		spBone* bone = self->bones[i];
+		memcpy(&bone->x, bones + i, sizeof(_spBonePose));
+		SUB_CAST(_spBone, bone)->dirty = 1;
+	}
 
 	for (i = 0; i < self->ikConstraintsCount; ++i) {
 		spIkConstraint* ikConstraint = self->ikConstraints[i];
@@ -230,37 +552,38 @@ void spSkeleton_setBonesToSetupPose (const spSkeleton* self) {
 
 void spSkeleton_setSlotsToSetupPose (const spSkeleton* self) {
 	int i;
+	const _spSlotPose* slots = _spSkeleton_getSetupPose(self)->slots;
 	memcpy(self->drawOrder, self->slots, self->slotsCount * sizeof(spSlot*));
-	for (i = 0; i < self->slotsCount; ++i)
-		spSlot_setToSetupPose(self->slots[i]);
+	for (i = 0; i < self->slotsCount; ++i) {
+		spSlot* slot = self->slots[i];
+		const _spSlotPose* pose = slots + i;
+		slot->r = pose->r;
+		slot->g = pose->g;
+		slot->b = pose->b;
+		slot->a = pose->a;
+		spSlot_setAttachment(slot, pose->attachment);
+	}
 }
 
 spBone* spSkeleton_findBone (const spSkeleton* self, const char* boneName) {
-	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->data->bones[i]->name, boneName) == 0) return self->bones[i];
-	return 0;
+	int i = spSkeleton_findBoneIndex(self, boneName);
+	return i == -1 ? 0 : self->bones[i];
 }
 
+/* The skeleton's bones, slots and IK constraints have the same indices as in its data. */
 int spSkeleton_findBoneIndex (const spSkeleton* self, const char* boneName) {
-	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->data->bones[i]->name, boneName) == 0) return i;
-	return -1;
+	int i = spSkeletonData_findBoneIndex(self->data, boneName);
+	return i < self->bonesCount ? i : -1;
 }
 
 spSlot* spSkeleton_findSlot (const spSkeleton* self, const char* slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->data->slots[i]->name, slotName) == 0) return self->slots[i];
-	return 0;
+	int i = spSkeleton_findSlotIndex(self, slotName);
+	return i == -1 ? 0 : self->slots[i];
 }
 
 int spSkeleton_findSlotIndex (const spSkeleton* self, const char* slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->data->slots[i]->name, slotName) == 0) return i;
-	return -1;
+	int i = spSkeletonData_findSlotIndex(self->data, slotName);
+	return i < self->slotsCount ? i : -1;
 }
 
 int spSkeleton_setSkinByName (spSkeleton* self, const char* skinName) {
@@ -316,28 +639,21 @@ spAttachment* spSkeleton_getAttachmentForSlotIndex (const spSkeleton* self, int
 }
 
 int spSkeleton_setAttachment (spSkeleton* self, const char* slotName, const char* attachmentName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i) {
-		spSlot *slot = self->slots[i];
-		if (strcmp(slot->data->name, slotName) == 0) {
-			if (!attachmentName)
-				spSlot_setAttachment(slot, 0);
-			else {
-				spAttachment* attachment = spSkeleton_getAttachmentForSlotIndex(self, i, attachmentName);
-				if (!attachment) return 0;
-				spSlot_setAttachment(slot, attachment);
-			}
-			return 1;
-		}
+	int i = spSkeleton_findSlotIndex(self, slotName);
+	if (i == -1) return 0;
+	if (!attachmentName)
+		spSlot_setAttachment(self->slots[i], 0);
+	else {
+		spAttachment* attachment = spSkeleton_getAttachmentForSlotIndex(self, i, attachmentName);
+		if (!attachment) return 0;
+		spSlot_setAttachment(self->slots[i], attachment);
 	}
-	return 0;
+	return 1;
 }
 
 spIkConstraint* spSkeleton_findIkConstraint (const spSkeleton* self, const char* ikConstraintName) {
-	int i;
-	for (i = 0; i < self->ikConstraintsCount; ++i)
-		if (strcmp(self->ikConstraints[i]->data->name, ikConstraintName) == 0) return self->ikConstraints[i];
-	return 0;
+	int i = _spSkeletonData_findIkConstraintIndex(self->data, ikConstraintName);
+	return i != -1 && i < self->ikConstraintsCount ? self->ikConstraints[i] : 0;
 }
 
 void spSkeleton_update (spSkeleton* self, float deltaTime) {
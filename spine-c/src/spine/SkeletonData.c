@@ -31,14 +31,26 @@
 
 #include <spine/SkeletonData.h>
 #include <string.h>
+#include <stddef.h>
 #include <spine/extension.h>
 
 spSkeletonData* spSkeletonData_create () {
-	return NEW(spSkeletonData);
+	return SUPER(NEW(_spSkeletonData));
 }
 
 void spSkeletonData_dispose (spSkeletonData* self) {
 	int i;
+
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+
+	spUpdateOrder_dispose(internal->updateOrder);
+	_spNameTable_dispose(&internal->bonesTable);
+	_spNameTable_dispose(&internal->slotsTable);
+	_spNameTable_dispose(&internal->skinsTable);
+	_spNameTable_dispose(&internal->eventsTable);
+	_spNameTable_dispose(&internal->animationsTable);
+	_spNameTable_dispose(&internal->ikConstraintsTable);
+
 	for (i = 0; i < self->bonesCount; ++i)
 		spBoneData_dispose(self->bones[i]);
 	FREE(self->bones);
@@ -69,58 +81,65 @@ void spSkeletonData_dispose (spSkeletonData* self) {
 	FREE(self);
 }
 
+const spUpdateOrder* spSkeletonData_getUpdateOrder (const spSkeletonData* self) {
+	_spSkeletonData* internal = SUB_CAST(_spSkeletonData, self);
+	if (!internal->updateOrder) internal->updateOrder = spUpdateOrder_create(self);
+	return internal->updateOrder;
+}
+
+#define BUILD_TABLE(TABLE,TYPE,ITEMS,COUNT) \
+	_spNameTable_build(&SUB_CAST(_spSkeletonData, self)->TABLE, ITEMS, COUNT, offsetof(TYPE, name))
+
+void spSkeletonData_buildNameTables (spSkeletonData* self) {
+	BUILD_TABLE(bonesTable, spBoneData, self->bones, self->bonesCount);
+	BUILD_TABLE(slotsTable, spSlotData, self->slots, self->slotsCount);
+	BUILD_TABLE(skinsTable, spSkin, self->skins, self->skinsCount);
+	BUILD_TABLE(eventsTable, spEventData, self->events, self->eventsCount);
+	BUILD_TABLE(animationsTable, spAnimation, self->animations, self->animationsCount);
+	BUILD_TABLE(ikConstraintsTable, spIkConstraintData, self->ikConstraints, self->ikConstraintsCount);
+}
+
+#define FIND_INDEX(TABLE,TYPE,ITEMS,COUNT,NAME) \
+	_spNameTable_find(&SUB_CAST(_spSkeletonData, self)->TABLE, ITEMS, COUNT, offsetof(TYPE, name), NAME)
+
 spBoneData* spSkeletonData_findBone (const spSkeletonData* self, const char* boneName) {
-	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->bones[i]->name, boneName) == 0) return self->bones[i];
-	return 0;
+	int i = spSkeletonData_findBoneIndex(self, boneName);
+	return i == -1 ? 0 : self->bones[i];
 }
 
 int spSkeletonData_findBoneIndex (const spSkeletonData* self, const char* boneName) {
-	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->bones[i]->name, boneName) == 0) return i;
-	return -1;
+	return FIND_INDEX(bonesTable, spBoneData, self->bones, self->bonesCount, boneName);
 }
 
 spSlotData* spSkeletonData_findSlot (const spSkeletonData* self, const char* slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->slots[i]->name, slotName) == 0) return self->slots[i];
-	return 0;
+	int i = spSkeletonData_findSlotIndex(self, slotName);
+	return i == -1 ? 0 : self->slots[i];
 }
 
 int spSkeletonData_findSlotIndex (const spSkeletonData* self, const char* slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->slots[i]->name, slotName) == 0) return i;
-	return -1;
+	return FIND_INDEX(slotsTable, spSlotData, self->slots, self->slotsCount, slotName);
 }
 
 spSkin* spSkeletonData_findSkin (const spSkeletonData* self, const char* skinName) {
-	int i;
-	for (i = 0; i < self->skinsCount; ++i)
-		if (strcmp(self->skins[i]->name, skinName) == 0) return self->skins[i];
-	return 0;
+	int i = FIND_INDEX(skinsTable, spSkin, self->skins, self->skinsCount, skinName);
+	return i == -1 ? 0 : self->skins[i];
 }
 
 spEventData* spSkeletonData_findEvent (const spSkeletonData* self, const char* eventName) {
-	int i;
-	for (i = 0; i < self->eventsCount; ++i)
-		if (strcmp(self->events[i]->name, eventName) == 0) return self->events[i];
-	return 0;
+	int i = FIND_INDEX(eventsTable, spEventData, self->events, self->eventsCount, eventName);
+	return i == -1 ? 0 : self->events[i];
 }
 
 spAnimation* spSkeletonData_findAnimation (const spSkeletonData* self, const char* animationName) {
-	int i;
-	for (i = 0; i < self->animationsCount; ++i)
-		if (strcmp(self->animations[i]->name, animationName) == 0) return self->animations[i];
-	return 0;
+	int i = FIND_INDEX(animationsTable, spAnimation, self->animations, self->animationsCount, animationName);
+	return i == -1 ? 0 : self->animations[i];
+}
+
+int _spSkeletonData_findIkConstraintIndex (const spSkeletonData* self, const char* ikConstraintName) {
+	return FIND_INDEX(ikConstraintsTable, spIkConstraintData, self->ikConstraints, self->ikConstraintsCount, ikConstraintName);
 }
 
 spIkConstraintData* spSkeletonData_findIkConstraint (const spSkeletonData* self, const char* ikConstraintName) {
-	int i;
-	for (i = 0; i < self->ikConstraintsCount; ++i)
-		if (strcmp(self->ikConstraints[i]->name, ikConstraintName) == 0) return self->ikConstraints[i];
-	return 0;
+	int i = _spSkeletonData_findIkConstraintIndex(self, ikConstraintName);
+	return i == -1 ? 0 : self->ikConstraints[i];
 }
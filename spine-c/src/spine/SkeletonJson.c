@@ -87,8 +87,9 @@ static float toColor (const char* value, int index) {
 	return color / (float)255;
 }
 
-static void readCurve (spCurveTimeline* timeline, int frameIndex, Json* frame) {
+static void readCurve (spSkeletonJson* self, spCurveTimeline* timeline, int frameIndex, Json* frame) {
 	Json* curve = Json_getItem(frame, "curve");
+	timeline->lookupError = self->curveLookupError;
 	if (!curve) return;
 	if (curve->type == Json_String && strcmp(curve->valueString, "stepped") == 0)
 		spCurveTimeline_setStepped(timeline, frameIndex);
@@ -156,7 +157,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 					const char* s = Json_getString(frame, "color", 0);
 					spColorTimeline_setFrame(timeline, i, Json_getFloat(frame, "time", 0), toColor(s, 0), toColor(s, 1), toColor(s, 2),
 							toColor(s, 3));
-					readCurve(SUPER(timeline), i, frame);
+					readCurve(self, SUPER(timeline), i, frame);
 				}
 				animation->timelines[animation->timelinesCount++] = SUPER_CAST(spTimeline, timeline);
 				duration = timeline->frames[timelineArray->size * 5 - 5];
@@ -199,7 +200,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 				timeline->boneIndex = boneIndex;
 				for (frame = timelineArray->child, i = 0; frame; frame = frame->next, ++i) {
 					spRotateTimeline_setFrame(timeline, i, Json_getFloat(frame, "time", 0), Json_getFloat(frame, "angle", 0));
-					readCurve(SUPER(timeline), i, frame);
+					readCurve(self, SUPER(timeline), i, frame);
 				}
 				animation->timelines[animation->timelinesCount++] = SUPER_CAST(spTimeline, timeline);
 				duration = timeline->frames[timelineArray->size * 2 - 2];
@@ -215,7 +216,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 					for (frame = timelineArray->child, i = 0; frame; frame = frame->next, ++i) {
 						spTranslateTimeline_setFrame(timeline, i, Json_getFloat(frame, "time", 0), Json_getFloat(frame, "x", 0) * scale,
 								Json_getFloat(frame, "y", 0) * scale);
-						readCurve(SUPER(timeline), i, frame);
+						readCurve(self, SUPER(timeline), i, frame);
 					}
 					animation->timelines[animation->timelinesCount++] = SUPER_CAST(spTimeline, timeline);
 					duration = timeline->frames[timelineArray->size * 3 - 3];
@@ -253,7 +254,7 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 		for (frame = ikMap->child, i = 0; frame; frame = frame->next, ++i) {
 			spIkConstraintTimeline_setFrame(timeline, i, Json_getFloat(frame, "time", 0), Json_getFloat(frame, "mix", 0),
 					Json_getInt(frame, "bendPositive", 1) ? 1 : -1);
-			readCurve(SUPER(timeline), i, frame);
+			readCurve(self, SUPER(timeline), i, frame);
 		}
 		animation->timelines[animation->timelinesCount++] = SUPER_CAST(spTimeline, timeline);
 		duration = timeline->frames[ikMap->size * 3 - 3];
@@ -286,39 +287,31 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 				timeline = spFFDTimeline_create(timelineArray->size, verticesCount);
 				timeline->slotIndex = slotIndex;
 				timeline->attachment = attachment;
+				if (attachment->type == SP_ATTACHMENT_MESH) timeline->setupVertices = SUB_CAST(spMeshAttachment, attachment)->vertices;
 
+				/* Frames store only the vertices they change, offset by the mesh's setup vertices. */
 				tempVertices = MALLOC(float, verticesCount);
 				for (frame = timelineArray->child, i = 0; frame; frame = frame->next, ++i) {
 					Json* vertices = Json_getItem(frame, "vertices");
-					float* frameVertices;
-					if (!vertices) {
-						if (attachment->type == SP_ATTACHMENT_MESH)
-							frameVertices = SUB_CAST(spMeshAttachment, attachment)->vertices;
-						else {
-							frameVertices = tempVertices;
-							memset(frameVertices, 0, sizeof(float) * verticesCount);
-						}
-					} else {
-						int v, start = Json_getInt(frame, "offset", 0);
+					int v = 0, start = 0;
+					if (vertices) {
 						Json* vertex;
-						frameVertices = tempVertices;
-						memset(frameVertices, 0, sizeof(float) * start);
+						start = Json_getInt(frame, "offset", 0);
 						if (self->scale == 1) {
-							for (vertex = vertices->child, v = start; vertex; vertex = vertex->next, ++v)
-								frameVertices[v] = vertex->valueFloat;
+							for (vertex = vertices->child; vertex; vertex = vertex->next, ++v)
+								tempVertices[v] = vertex->valueFloat;
 						} else {
-							for (vertex = vertices->child, v = start; vertex; vertex = vertex->next, ++v)
-								frameVertices[v] = vertex->valueFloat * self->scale;
+							for (vertex = vertices->child; vertex; vertex = vertex->next, ++v)
+								tempVertices[v] = vertex->valueFloat * self->scale;
 						}
-						memset(frameVertices + v, 0, sizeof(float) * (verticesCount - v));
-						if (attachment->type == SP_ATTACHMENT_MESH) {
-							float* meshVertices = SUB_CAST(spMeshAttachment, attachment)->vertices;
-							for (v = 0; v < verticesCount; ++v)
-								frameVertices[v] += meshVertices[v];
+						if (timeline->setupVertices) {
+							int ii;
+							for (ii = 0; ii < v; ++ii)
+								tempVertices[ii] += timeline->setupVertices[start + ii];
 						}
 					}
-					spFFDTimeline_setFrame(timeline, i, Json_getFloat(frame, "time", 0), frameVertices);
-					readCurve(SUPER(timeline), i, frame);
+					spFFDTimeline_setFrameRange(timeline, i, Json_getFloat(frame, "time", 0), start, v, tempVertices);
+					readCurve(self, SUPER(timeline), i, frame);
 				}
 				FREE(tempVertices);
 
@@ -470,10 +463,14 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 		boneData->flipX = Json_getInt(boneMap, "flipX", 0);
 		boneData->flipY = Json_getInt(boneMap, "flipY", 0);
 
+		CONST_CAST(int, boneData->index) = i;
 		skeletonData->bones[i] = boneData;
 		skeletonData->bonesCount++;
 	}
 
+	/* Parents precede their children, so the lookups above scan the bones read so far. */
+	spSkeletonData_buildNameTables(skeletonData);
+
 	/* IK constraints. */
 	ik = Json_getItem(root, "ik");
 	if (ik) {
@@ -553,10 +550,13 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 					slotData->blendMode = SP_BLEND_MODE_SCREEN;
 			}
 
+			CONST_CAST(int, slotData->index) = i;
 			skeletonData->slots[i] = slotData;
 		}
 	}
 
+	spSkeletonData_buildNameTables(skeletonData);
+
 	/* Skins. */
 	skins = Json_getItem(root, "skins");
 	if (skins) {
@@ -783,6 +783,8 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 		}
 	}
 
+	spSkeletonData_buildNameTables(skeletonData);
+
 	/* Animations. */
 	animations = Json_getItem(root, "animations");
 	if (animations) {
@@ -792,6 +794,8 @@ spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const cha
 			_spSkeletonJson_readAnimation(self, animationMap, skeletonData);
 	}
 
+	spSkeletonData_buildNameTables(skeletonData);
+
 	Json_dispose(root);
 	return skeletonData;
 }
@@ -0,0 +1,310 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonPose.h>
+#include <stddef.h>
+#include <spine/extension.h>
+
+typedef struct {
+	/* Same layout as the spBone fields from x to flipY. */
+	float x, y;
+	float rotation, rotationIK;
+	float scaleX, scaleY;
+	int/*bool*/flipX, flipY;
+} _spBoneState;
+
+/* Fails to compile if the spBone fields from x to flipY no longer match _spBoneState. */
+typedef char _spBoneState_matchesBone[
+		offsetof(spBone, flipY) + sizeof(int) - offsetof(spBone, x) == sizeof(_spBoneState)
+		&& offsetof(spBone, scaleX) - offsetof(spBone, x) == offsetof(_spBoneState, scaleX) ? 1 : -1];
+
+typedef struct {
+	spAttachment* attachment;
+	float r, g, b, a;
+	float attachmentTime;
+	int attachmentVerticesCount;
+	int verticesOffset; /* Of the slot's attachment vertices in the pose's vertices. */
+} _spSlotState;
+
+typedef struct {
+	float mix;
+	int bendDirection;
+} _spIkConstraintState;
+
+typedef struct {
+	spSkeletonPose super;
+
+	spSkin* skin;
+	float r, g, b, a;
+	float time;
+	int/*bool*/flipX, flipY;
+	float x, y;
+
+	_spSlotState* slots;
+	spSlot** drawOrder;
+	_spBoneState* bones;
+	_spIkConstraintState* ikConstraints;
+
+	int verticesCapacity;
+	float* vertices; /* The attachment vertices of all slots, packed in slot order. */
+} _spSkeletonPose;
+
+spSkeletonPose* spSkeletonPose_create (const spSkeleton* skeleton) {
+	int i, ii, verticesCapacity = 0, *slotVertices;
+	spSkeletonPose* self;
+	_spSkeletonPose* internal;
+	const spSkeletonData* data = skeleton->data;
+
+	/* Pointer aligned arrays first. */
+	internal = (_spSkeletonPose*)CALLOC(char, sizeof(_spSkeletonPose) + sizeof(_spSlotState) * skeleton->slotsCount
+			+ sizeof(spSlot*) * skeleton->slotsCount + sizeof(_spBoneState) * skeleton->bonesCount
+			+ sizeof(_spIkConstraintState) * skeleton->ikConstraintsCount);
+	self = SUPER(internal);
+	CONST_CAST(int, self->bonesCount) = skeleton->bonesCount;
+	CONST_CAST(int, self->slotsCount) = skeleton->slotsCount;
+	CONST_CAST(int, self->ikConstraintsCount) = skeleton->ikConstraintsCount;
+	internal->slots = (_spSlotState*)(internal + 1);
+	internal->drawOrder = (spSlot**)(internal->slots + skeleton->slotsCount);
+	internal->bones = (_spBoneState*)(internal->drawOrder + skeleton->slotsCount);
+	internal->ikConstraints = (_spIkConstraintState*)(internal->bones + skeleton->bonesCount);
+
+	/* Reserve the most vertices each slot can have: its current vertices or its largest FFD frame. */
+	slotVertices = MALLOC(int, skeleton->slotsCount);
+	for (i = 0; i < skeleton->slotsCount; ++i)
+		slotVertices[i] = skeleton->slots[i]->attachmentVerticesCount;
+	for (i = 0; i < data->animationsCount; ++i) {
+		spAnimation* animation = data->animations[i];
+		for (ii = 0; ii < animation->timelinesCount; ++ii) {
+			spFFDTimeline* timeline;
+			if (animation->timelines[ii]->type != SP_TIMELINE_FFD) continue;
+			timeline = SUB_CAST(spFFDTimeline, animation->timelines[ii]);
+			if (timeline->slotIndex < skeleton->slotsCount && timeline->frameVerticesCount > slotVertices[timeline->slotIndex])
+				slotVertices[timeline->slotIndex] = timeline->frameVerticesCount;
+		}
+	}
+	for (i = 0; i < skeleton->slotsCount; ++i)
+		verticesCapacity += slotVertices[i];
+	FREE(slotVertices);
+	internal->verticesCapacity = verticesCapacity;
+	internal->vertices = MALLOC(float, verticesCapacity);
+	return self;
+}
+
+void spSkeletonPose_dispose (spSkeletonPose* self) {
+	FREE(SUB_CAST(_spSkeletonPose, self)->vertices);
+	FREE(self);
+}
+
+void spSkeleton_savePose (const spSkeleton* self, spSkeletonPose* pose) {
+	int i, verticesCount = 0;
+	_spSkeletonPose* internal = SUB_CAST(_spSkeletonPose, pose);
+	float* vertices;
+
+	internal->skin = self->skin;
+	internal->r = self->r;
+	internal->g = self->g;
+	internal->b = self->b;
+	internal->a = self->a;
+	internal->time = self->time;
+	internal->flipX = self->flipX;
+	internal->flipY = self->flipY;
+	internal->x = self->x;
+	internal->y = self->y;
+
+	for (i = 0; i < self->bonesCount; ++i)
+		memcpy(internal->bones + i, &self->bones[i]->x, sizeof(_spBoneState));
+
+	for (i = 0; i < self->slotsCount; ++i)
+		verticesCount += self->slots[i]->attachmentVerticesCount;
+	if (verticesCount > internal->verticesCapacity) {
+		FREE(internal->vertices);
+		internal->vertices = MALLOC(float, verticesCount);
+		internal->verticesCapacity = verticesCount;
+	}
+	vertices = internal->vertices;
+	for (i = 0; i < self->slotsCount; ++i) {
+		spSlot* slot = self->slots[i];
+		_spSlotState* state = internal->slots + i;
+		state->attachment = slot->attachment;
+		state->r = slot->r;
+		state->g = slot->g;
+		state->b = slot->b;
+		state->a = slot->a;
+		state->attachmentTime = SUB_CAST(_spSlot, slot)->attachmentTime;
+		state->attachmentVerticesCount = slot->attachmentVerticesCount;
+		state->verticesOffset = (int)(vertices - internal->vertices);
+		if (slot->attachmentVerticesCount) {
+			memcpy(vertices, slot->attachmentVertices, sizeof(float) * slot->attachmentVerticesCount);
+			vertices += slot->attachmentVerticesCount;
+		}
+	}
+	memcpy(internal->drawOrder, self->drawOrder, sizeof(spSlot*) * self->slotsCount);
+
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		internal->ikConstraints[i].mix = self->ikConstraints[i]->mix;
+		internal->ikConstraints[i].bendDirection = self->ikConstraints[i]->bendDirection;
+	}
+}
+
+void spSkeleton_restorePose (spSkeleton* self, const spSkeletonPose* pose) {
+	int i;
+	const _spSkeletonPose* internal = SUB_CAST(_spSkeletonPose, pose);
+	const float* vertices;
+
+	CONST_CAST(spSkin*, self->skin) = internal->skin;
+	self->r = internal->r;
+	self->g = internal->g;
+	self->b = internal->b;
+	self->a = internal->a;
+	self->time = internal->time;
+	self->flipX = internal->flipX;
+	self->flipY = internal->flipY;
+	self->x = internal->x;
+	self->y = internal->y;
+
+	for (i = 0; i < self->bonesCount; ++i) {
+		memcpy(&self->bones[i]->x, internal->bones + i, sizeof(_spBoneState));
+		SUB_CAST(_spBone, self->bones[i])->dirty = 1;
+	}
+
+	vertices = internal->vertices;
+	for (i = 0; i < self->slotsCount; ++i) {
+		spSlot* slot = self->slots[i];
+		const _spSlotState* state = internal->slots + i;
+		slot->attachment = state->attachment;
+		slot->r = state->r;
+		slot->g = state->g;
+		slot->b = state->b;
+		slot->a = state->a;
+		SUB_CAST(_spSlot, slot)->attachmentTime = state->attachmentTime;
+		if (slot->attachmentVerticesCapacity < state->attachmentVerticesCount) {
+			FREE(slot->attachmentVertices);
+			slot->attachmentVertices = MALLOC(float, state->attachmentVerticesCount);
+			slot->attachmentVerticesCapacity = state->attachmentVerticesCount;
+		}
+		slot->attachmentVerticesCount = state->attachmentVerticesCount;
+		if (state->attachmentVerticesCount) {
+			memcpy(slot->attachmentVertices, vertices, sizeof(float) * state->attachmentVerticesCount);
+			vertices += state->attachmentVerticesCount;
+		}
+	}
+	memcpy(self->drawOrder, internal->drawOrder, sizeof(spSlot*) * self->slotsCount);
+
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		self->ikConstraints[i]->mix = internal->ikConstraints[i].mix;
+		self->ikConstraints[i]->bendDirection = internal->ikConstraints[i].bendDirection;
+	}
+}
+
+int spSkeleton_restoreAnimationPose (spSkeleton* self, const spSkeletonPose* pose, const spAnimation* animation,
+		float time, int loop) {
+	int i;
+	const _spSkeletonPose* internal = SUB_CAST(_spSkeletonPose, pose);
+
+	for (i = 0; i < animation->timelinesCount; ++i)
+		if (_spTimeline_getStartTime(animation->timelines[i]) < 0) return 0;
+
+	if (loop && animation->duration) time = FMOD(time, animation->duration);
+
+	for (i = 0; i < animation->timelinesCount; ++i) {
+		const spTimeline* timeline = animation->timelines[i];
+		int index = _spTimeline_getIndex(timeline);
+		if (time < _spTimeline_getStartTime(timeline)) continue; /* Applying the timeline changes nothing. */
+		switch (timeline->type) {
+		case SP_TIMELINE_ROTATE: {
+			spBone* bone = self->bones[index];
+			if (bone->rotation != internal->bones[index].rotation) {
+				bone->rotation = internal->bones[index].rotation;
+				spBone_markDirty(bone);
+			}
+			break;
+		}
+		case SP_TIMELINE_TRANSLATE: {
+			spBone* bone = self->bones[index];
+			if (bone->x != internal->bones[index].x || bone->y != internal->bones[index].y) {
+				bone->x = internal->bones[index].x;
+				bone->y = internal->bones[index].y;
+				spBone_markDirty(bone);
+			}
+			break;
+		}
+		case SP_TIMELINE_SCALE: {
+			spBone* bone = self->bones[index];
+			if (bone->scaleX != internal->bones[index].scaleX || bone->scaleY != internal->bones[index].scaleY) {
+				bone->scaleX = internal->bones[index].scaleX;
+				bone->scaleY = internal->bones[index].scaleY;
+				spBone_markDirty(bone);
+			}
+			break;
+		}
+		case SP_TIMELINE_COLOR: {
+			spSlot* slot = self->slots[index];
+			slot->r = internal->slots[index].r;
+			slot->g = internal->slots[index].g;
+			slot->b = internal->slots[index].b;
+			slot->a = internal->slots[index].a;
+			break;
+		}
+		case SP_TIMELINE_FFD: {
+			/* The timeline only sets the vertices of its attachment. */
+			spSlot* slot = self->slots[index];
+			const _spSlotState* state = internal->slots + index;
+			spAttachment* attachment = SUB_CAST(spFFDTimeline, timeline)->attachment;
+			if (slot->attachment != attachment || state->attachment != attachment) break;
+			if (slot->attachmentVerticesCapacity < state->attachmentVerticesCount) {
+				FREE(slot->attachmentVertices);
+				slot->attachmentVertices = MALLOC(float, state->attachmentVerticesCount);
+				slot->attachmentVerticesCapacity = state->attachmentVerticesCount;
+			}
+			slot->attachmentVerticesCount = state->attachmentVerticesCount;
+			memcpy(slot->attachmentVertices, internal->vertices + state->verticesOffset,
+					sizeof(float) * state->attachmentVerticesCount);
+			break;
+		}
+		case SP_TIMELINE_IKCONSTRAINT: {
+			spIkConstraint* ikConstraint = self->ikConstraints[index];
+			if (ikConstraint->mix != internal->ikConstraints[index].mix
+					|| ikConstraint->bendDirection != internal->ikConstraints[index].bendDirection) {
+				ikConstraint->mix = internal->ikConstraints[index].mix;
+				ikConstraint->bendDirection = internal->ikConstraints[index].bendDirection;
+				spBone_markDirty(ikConstraint->bones[0]);
+			}
+			break;
+		}
+		case SP_TIMELINE_DRAWORDER:
+			memcpy(self->drawOrder, internal->drawOrder, sizeof(spSlot*) * self->slotsCount);
+			break;
+		default:
+			break;
+		}
+	}
+	return 1;
+}
@@ -0,0 +1,309 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonTransforms.h>
+#include <spine/extension.h>
+#include <string.h>
+
+spSkeletonTransforms* spSkeletonTransforms_create (const spSkeletonData* data) {
+	int i, n = data->bonesCount, ik = data->ikConstraintsCount;
+	int* ints;
+	float* floats;
+	spSkeletonTransforms* self = (spSkeletonTransforms*)CALLOC(char,
+			sizeof(spSkeletonTransforms) + sizeof(int) * (n * 7 + ik * 4) + sizeof(float) * (n * 16 + ik));
+	CONST_CAST(int, self->bonesCount) = n;
+	CONST_CAST(int, self->ikConstraintsCount) = ik;
+	CONST_CAST(spUpdateOrder*, self->updateOrder) = (spUpdateOrder*)spSkeletonData_getUpdateOrder(data);
+
+	ints = (int*)(self + 1);
+	CONST_CAST(int*, self->parentIndices) = ints;
+	CONST_CAST(int*, self->inheritScale) = ints + n;
+	CONST_CAST(int*, self->inheritRotation) = ints + n * 2;
+	CONST_CAST(int*, self->flipX) = ints + n * 3;
+	CONST_CAST(int*, self->flipY) = ints + n * 4;
+	CONST_CAST(int*, self->worldFlipX) = ints + n * 5;
+	CONST_CAST(int*, self->worldFlipY) = ints + n * 6;
+	CONST_CAST(int*, self->ikBones) = ints + n * 7;
+	CONST_CAST(int*, self->ikTargets) = ints + n * 7 + ik * 2;
+	CONST_CAST(int*, self->ikBendDirections) = ints + n * 7 + ik * 3;
+
+	floats = (float*)(ints + n * 7 + ik * 4);
+	CONST_CAST(float*, self->length) = floats;
+	CONST_CAST(float*, self->x) = floats + n;
+	CONST_CAST(float*, self->y) = floats + n * 2;
+	CONST_CAST(float*, self->rotation) = floats + n * 3;
+	CONST_CAST(float*, self->scaleX) = floats + n * 4;
+	CONST_CAST(float*, self->scaleY) = floats + n * 5;
+	CONST_CAST(float*, self->rotationIK) = floats + n * 6;
+	CONST_CAST(float*, self->m00) = floats + n * 7;
+	CONST_CAST(float*, self->m01) = floats + n * 8;
+	CONST_CAST(float*, self->worldX) = floats + n * 9;
+	CONST_CAST(float*, self->m10) = floats + n * 10;
+	CONST_CAST(float*, self->m11) = floats + n * 11;
+	CONST_CAST(float*, self->worldY) = floats + n * 12;
+	CONST_CAST(float*, self->worldRotation) = floats + n * 13;
+	CONST_CAST(float*, self->worldScaleX) = floats + n * 14;
+	CONST_CAST(float*, self->worldScaleY) = floats + n * 15;
+	CONST_CAST(float*, self->ikMixes) = floats + n * 16;
+
+	for (i = 0; i < n; ++i) {
+		const spBoneData* boneData = data->bones[i];
+		CONST_CAST(int, self->parentIndices[i]) = boneData->parent ? boneData->parent->index : -1;
+		CONST_CAST(int, self->inheritScale[i]) = boneData->inheritScale;
+		CONST_CAST(int, self->inheritRotation[i]) = boneData->inheritRotation;
+		CONST_CAST(float, self->length[i]) = boneData->length;
+		self->x[i] = boneData->x;
+		self->y[i] = boneData->y;
+		self->rotation[i] = boneData->rotation;
+		self->scaleX[i] = boneData->scaleX;
+		self->scaleY[i] = boneData->scaleY;
+		self->flipX[i] = boneData->flipX;
+		self->flipY[i] = boneData->flipY;
+	}
+	for (i = 0; i < ik; ++i) {
+		const spIkConstraintData* ikData = data->ikConstraints[i];
+		/* spIkConstraint_apply ignores constraints with other bone counts. */
+		CONST_CAST(int, self->ikBones[i * 2]) = ikData->bonesCount == 1 || ikData->bonesCount == 2 ? ikData->bones[0]->index : -1;
+		CONST_CAST(int, self->ikBones[i * 2 + 1]) = ikData->bonesCount == 2 ? ikData->bones[1]->index : -1;
+		CONST_CAST(int, self->ikTargets[i]) = ikData->target->index;
+		self->ikBendDirections[i] = ikData->bendDirection;
+		self->ikMixes[i] = ikData->mix;
+	}
+	return self;
+}
+
+void spSkeletonTransforms_dispose (spSkeletonTransforms* self) {
+	FREE(self);
+}
+
+void spSkeletonTransforms_readBones (spSkeletonTransforms* self, const spSkeleton* skeleton) {
+	int i;
+	for (i = 0; i < self->bonesCount; ++i) {
+		const spBone* bone = skeleton->bones[i];
+		self->x[i] = bone->x;
+		self->y[i] = bone->y;
+		self->rotation[i] = bone->rotation;
+		self->scaleX[i] = bone->scaleX;
+		self->scaleY[i] = bone->scaleY;
+		self->flipX[i] = bone->flipX;
+		self->flipY[i] = bone->flipY;
+	}
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		self->ikBendDirections[i] = skeleton->ikConstraints[i]->bendDirection;
+		self->ikMixes[i] = skeleton->ikConstraints[i]->mix;
+	}
+}
+
+/* Must match spBone_updateWorldTransform exactly. */
+static void _spSkeletonTransforms_updateBone (spSkeletonTransforms* self, int i, int flipX, int flipY, int yDown) {
+	float cosine, sine, worldScaleX, worldScaleY;
+	int worldFlipX, worldFlipY, parent = self->parentIndices[i];
+	float x = self->x[i], y = self->y[i], rotation = self->rotationIK[i];
+
+	if (parent != -1) {
+		self->worldX[i] = x * self->m00[parent] + y * self->m01[parent] + self->worldX[parent];
+		self->worldY[i] = x * self->m10[parent] + y * self->m11[parent] + self->worldY[parent];
+		if (self->inheritScale[i]) {
+			worldScaleX = self->worldScaleX[parent] * self->scaleX[i];
+			worldScaleY = self->worldScaleY[parent] * self->scaleY[i];
+		} else {
+			worldScaleX = self->scaleX[i];
+			worldScaleY = self->scaleY[i];
+		}
+		self->worldRotation[i] = self->inheritRotation[i] ? self->worldRotation[parent] + rotation : rotation;
+		worldFlipX = self->worldFlipX[parent] ^ self->flipX[i];
+		worldFlipY = self->worldFlipY[parent] ^ self->flipY[i];
+	} else {
+		self->worldX[i] = flipX ? -x : x;
+		self->worldY[i] = flipY != yDown ? -y : y;
+		worldScaleX = self->scaleX[i];
+		worldScaleY = self->scaleY[i];
+		self->worldRotation[i] = rotation;
+		worldFlipX = flipX ^ self->flipX[i];
+		worldFlipY = flipY ^ self->flipY[i];
+	}
+	self->worldScaleX[i] = worldScaleX;
+	self->worldScaleY[i] = worldScaleY;
+	self->worldFlipX[i] = worldFlipX;
+	self->worldFlipY[i] = worldFlipY;
+
+	SIN_COS(self->worldRotation[i] * DEG_RAD, sine, cosine);
+	if (worldFlipX) {
+		self->m00[i] = -cosine * worldScaleX;
+		self->m01[i] = sine * worldScaleY;
+	} else {
+		self->m00[i] = cosine * worldScaleX;
+		self->m01[i] = -sine * worldScaleY;
+	}
+	if (worldFlipY != yDown) {
+		self->m10[i] = -sine * worldScaleX;
+		self->m11[i] = -cosine * worldScaleY;
+	} else {
+		self->m10[i] = sine * worldScaleX;
+		self->m11[i] = cosine * worldScaleY;
+	}
+}
+
+/* Same as spBone_worldToLocal. */
+static void _spSkeletonTransforms_worldToLocal (const spSkeletonTransforms* self, int i, float worldX, float worldY,
+		float* localX, float* localY, int yDown) {
+	float invDet;
+	float dx = worldX - self->worldX[i], dy = worldY - self->worldY[i];
+	float m00 = self->m00[i], m11 = self->m11[i];
+	if (self->worldFlipX[i] != (self->worldFlipY[i] != yDown)) {
+		m00 *= -1;
+		m11 *= -1;
+	}
+	invDet = 1 / (m00 * m11 - self->m01[i] * self->m10[i]);
+	*localX = (dx * m00 * invDet - dy * self->m01[i] * invDet);
+	*localY = (dy * m11 * invDet - dx * self->m10[i] * invDet);
+}
+
+/* Same as spIkConstraint_apply1. */
+static void _spSkeletonTransforms_applyIk1 (spSkeletonTransforms* self, int bone, float targetX, float targetY, float alpha,
+		int yDown) {
+	int parent = self->parentIndices[bone];
+	float parentRotation = (!self->inheritRotation[bone] || parent == -1) ? 0 : self->worldRotation[parent];
+	float rotation = self->rotation[bone];
+	float rotationIK = ATAN2(targetY - self->worldY[bone], targetX - self->worldX[bone]) * RAD_DEG;
+	if (self->worldFlipX[bone] != (self->worldFlipY[bone] != yDown)) rotationIK = -rotationIK;
+	rotationIK -= parentRotation;
+	self->rotationIK[bone] = rotation + (rotationIK - rotation) * alpha;
+}
+
+/* Same as spIkConstraint_apply2. */
+static void _spSkeletonTransforms_applyIk2 (spSkeletonTransforms* self, int parent, int child, float targetX, float targetY,
+		int bendDirection, float alpha, int yDown) {
+	float positionX, positionY, childX, childY, offset, len1, len2, cosDenom, cos, childAngle, adjacent, opposite, parentAngle, rotation;
+	int parentParent, childParent;
+	float childRotation = self->rotation[child], parentRotation = self->rotation[parent];
+	if (alpha == 0) {
+		self->rotationIK[child] = childRotation;
+		self->rotationIK[parent] = parentRotation;
+		return;
+	}
+	parentParent = self->parentIndices[parent];
+	if (parentParent != -1) {
+		_spSkeletonTransforms_worldToLocal(self, parentParent, targetX, targetY, &positionX, &positionY, yDown);
+		targetX = (positionX - self->x[parent]) * self->worldScaleX[parentParent];
+		targetY = (positionY - self->y[parent]) * self->worldScaleY[parentParent];
+	} else {
+		targetX -= self->x[parent];
+		targetY -= self->y[parent];
+	}
+	childParent = self->parentIndices[child];
+	if (childParent == parent) {
+		positionX = self->x[child];
+		positionY = self->y[child];
+	} else {
+		float localX = self->x[child], localY = self->y[child];
+		positionX = localX * self->m00[childParent] + localY * self->m01[childParent] + self->worldX[childParent];
+		positionY = localX * self->m10[childParent] + localY * self->m11[childParent] + self->worldY[childParent];
+		_spSkeletonTransforms_worldToLocal(self, parent, positionX, positionY, &positionX, &positionY, yDown);
+	}
+	childX = positionX * self->worldScaleX[parent];
+	childY = positionY * self->worldScaleY[parent];
+	offset = ATAN2(childY, childX);
+	len1 = SQRT(childX * childX + childY * childY);
+	len2 = self->length[child] * self->worldScaleX[child];
+	/* Based on code by Ryan Juckett with permission: Copyright (c) 2008-2009 Ryan Juckett, http://www.ryanjuckett.com/ */
+	cosDenom = 2 * len1 * len2;
+	if (cosDenom < 0.0001f) {
+		self->rotationIK[child] = childRotation + (ATAN2(targetY, targetX) * RAD_DEG - parentRotation - childRotation) * alpha;
+		return;
+	}
+	cos = (targetX * targetX + targetY * targetY - len1 * len1 - len2 * len2) / cosDenom;
+	if (cos < -1)
+		cos = -1;
+	else if (cos > 1) /**/
+		cos = 1;
+	childAngle = ACOS(cos) * bendDirection;
+	adjacent = len1 + len2 * cos;
+	opposite = len2 * SIN(childAngle);
+	parentAngle = ATAN2(targetY * adjacent - targetX * opposite, targetX * adjacent + targetY * opposite);
+	rotation = (parentAngle - offset) * RAD_DEG - parentRotation;
+	if (rotation > 180)
+		rotation -= 360;
+	else if (rotation < -180) /**/
+		rotation += 360;
+	self->rotationIK[parent] = parentRotation + rotation * alpha;
+	rotation = (childAngle + offset) * RAD_DEG - childRotation;
+	if (rotation > 180)
+		rotation -= 360;
+	else if (rotation < -180) /**/
+		rotation += 360;
+	self->rotationIK[child] = childRotation
+			+ (rotation + self->worldRotation[parent] - self->worldRotation[childParent]) * alpha;
+}
+
+void spSkeletonTransforms_update (spSkeletonTransforms* self, int flipX, int flipY) {
+	int i, ii, yDown = spBone_isYDown();
+	const spUpdateOrder* order = self->updateOrder;
+
+	memcpy(self->rotationIK, self->rotation, sizeof(float) * self->bonesCount);
+	for (i = 0, ii = 0; ; ++i) {
+		int bone, target;
+		for (; ii < order->segmentEnds[i]; ++ii)
+			_spSkeletonTransforms_updateBone(self, order->indices[ii], flipX, flipY, yDown);
+		if (i == order->ikConstraintsCount) break;
+
+		bone = self->ikBones[i * 2];
+		target = self->ikTargets[i];
+		if (bone == -1) continue;
+		if (self->ikBones[i * 2 + 1] == -1)
+			_spSkeletonTransforms_applyIk1(self, bone, self->worldX[target], self->worldY[target], self->ikMixes[i], yDown);
+		else {
+			_spSkeletonTransforms_applyIk2(self, bone, self->ikBones[i * 2 + 1], self->worldX[target], self->worldY[target],
+					self->ikBendDirections[i], self->ikMixes[i], yDown);
+		}
+	}
+}
+
+void spSkeletonTransforms_writeBones (const spSkeletonTransforms* self, spSkeleton* skeleton) {
+	int i;
+	for (i = 0; i < self->bonesCount; ++i) {
+		spBone* bone = skeleton->bones[i];
+		bone->rotationIK = self->rotationIK[i];
+		CONST_CAST(float, bone->m00) = self->m00[i];
+		CONST_CAST(float, bone->m01) = self->m01[i];
+		CONST_CAST(float, bone->worldX) = self->worldX[i];
+		CONST_CAST(float, bone->m10) = self->m10[i];
+		CONST_CAST(float, bone->m11) = self->m11[i];
+		CONST_CAST(float, bone->worldY) = self->worldY[i];
+		CONST_CAST(float, bone->worldRotation) = self->worldRotation[i];
+		CONST_CAST(float, bone->worldScaleX) = self->worldScaleX[i];
+		CONST_CAST(float, bone->worldScaleY) = self->worldScaleY[i];
+		CONST_CAST(int, bone->worldFlipX) = self->worldFlipX[i];
+		CONST_CAST(int, bone->worldFlipY) = self->worldFlipY[i];
+	}
+	/* The bones' world transforms no longer follow their dirty flags. */
+	SUB_CAST(_spSkeleton, skeleton)->worldValid = 0;
+}
@@ -59,11 +59,16 @@ void _Entry_dispose (_Entry* self) {
 typedef struct {
 	spSkin super;
 	_Entry* entries;
+	int revision;
 } _spSkin;
 
+/* Not synchronized, revisions are only compared along with the skin pointer. */
+static int lastRevision = 0;
+
 spSkin* spSkin_create (const char* name) {
 	spSkin* self = SUPER(NEW(_spSkin));
 	MALLOC_STR(self->name, name);
+	SUB_CAST(_spSkin, self)->revision = ++lastRevision;
 	return self;
 }
 
@@ -83,6 +88,11 @@ void spSkin_addAttachment (spSkin* self, int slotIndex, const char* name, spAtta
 	_Entry* newEntry = _Entry_create(slotIndex, name, attachment);
 	newEntry->next = SUB_CAST(_spSkin, self)->entries;
 	SUB_CAST(_spSkin, self)->entries = newEntry;
+	SUB_CAST(_spSkin, self)->revision = ++lastRevision;
+}
+
+int _spSkin_getRevision (const spSkin* self) {
+	return SUB_CAST(_spSkin, self)->revision;
 }
 
 
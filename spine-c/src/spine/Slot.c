@@ -32,16 +32,15 @@
 #include <spine/Slot.h>
 #include <spine/extension.h>
 
-typedef struct {
-	spSlot super;
-	float attachmentTime;
-} _spSlot;
-
-spSlot* spSlot_create (spSlotData* data, spBone* bone) {
-	spSlot* self = SUPER(NEW(_spSlot));
+void _spSlot_init (spSlot* self, spSlotData* data, spBone* bone) {
 	CONST_CAST(spSlotData*, self->data) = data;
 	CONST_CAST(spBone*, self->bone) = bone;
 	spSlot_setToSetupPose(self);
+}
+
+spSlot* spSlot_create (spSlotData* data, spBone* bone) {
+	spSlot* self = SUPER(NEW(_spSlot));
+	_spSlot_init(self, data, bone);
 	return self;
 }
 
@@ -64,23 +63,18 @@ float spSlot_getAttachmentTime (const spSlot* self) {
 	return self->bone->skeleton->time - SUB_CAST(_spSlot, self) ->attachmentTime;
 }
 
-void spSlot_setToSetupPose (spSlot* self) {
-	spAttachment* attachment = 0;
+spAttachment* _spSlot_getSetupAttachment (const spSlot* self) {
+	const spSkeleton* skeleton = self->bone->skeleton;
+	int i = self->data->index;
+	if (!self->data->attachmentName) return 0;
+	if (i >= skeleton->data->slotsCount || skeleton->data->slots[i] != self->data) return 0;
+	return spSkeleton_getAttachmentForSlotIndex(skeleton, i, self->data->attachmentName);
+}
 
+void spSlot_setToSetupPose (spSlot* self) {
 	self->r = self->data->r;
 	self->g = self->data->g;
 	self->b = self->data->b;
 	self->a = self->data->a;
-
-	if (self->data->attachmentName) {
-		/* Find slot index. */
-		int i;
-		for (i = 0; i < self->bone->skeleton->data->slotsCount; ++i) {
-			if (self->data == self->bone->skeleton->data->slots[i]) {
-				attachment = spSkeleton_getAttachmentForSlotIndex(self->bone->skeleton, i, self->data->attachmentName);
-				break;
-			}
-		}
-	}
-	spSlot_setAttachment(self, attachment);
+	spSlot_setAttachment(self, _spSlot_getSetupAttachment(self));
 }
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/UpdateOrder.h>
+#include <spine/extension.h>
+
+spUpdateOrder* _spUpdateOrder_create (int bonesCount, const int* parents, int ikConstraintsCount, const int* ikParents,
+		const int* ikChildren) {
+	int i, ii, total, *indices, *segmentEnds, *ikIndices, *offsets;
+	spUpdateOrder* self;
+
+	/* A bone's IK index is that of the first IK constraint whose parent to child chain contains the bone or its nearest
+	 * ancestor in any chain. */
+	ikIndices = MALLOC(int, bonesCount);
+	for (i = 0; i < bonesCount; ++i)
+		ikIndices[i] = -2;
+	for (i = 0; i < ikConstraintsCount; ++i) {
+		int bone = ikChildren[i];
+		while (bone != -1) {
+			if (ikIndices[bone] == -2) ikIndices[bone] = i;
+			if (bone == ikParents[i]) break;
+			bone = parents[bone];
+		}
+	}
+	for (i = 0; i < bonesCount; ++i) {
+		int ikIndex, bone = i;
+		while (ikIndices[bone] == -2 && parents[bone] != -1)
+			bone = parents[bone];
+		ikIndex = ikIndices[bone] == -2 ? -1 : ikIndices[bone];
+		for (bone = i; bone != -1 && ikIndices[bone] == -2; bone = parents[bone])
+			ikIndices[bone] = ikIndex;
+	}
+
+	/* Bones not affected by IK are in the first segment, others are in the segments before and after their IK constraint. */
+	offsets = CALLOC(int, ikConstraintsCount + 1);
+	for (i = 0, total = 0; i < bonesCount; ++i) {
+		if (ikIndices[i] == -1) {
+			offsets[0]++;
+			total++;
+		} else {
+			offsets[ikIndices[i]]++;
+			offsets[ikIndices[i] + 1]++;
+			total += 2;
+		}
+	}
+
+	self = (spUpdateOrder*)CALLOC(char, sizeof(spUpdateOrder) + sizeof(int) * (total + ikConstraintsCount + 1 + bonesCount));
+	CONST_CAST(int, self->bonesCount) = bonesCount;
+	CONST_CAST(int, self->ikConstraintsCount) = ikConstraintsCount;
+	CONST_CAST(int, self->indicesCount) = total;
+	indices = (int*)(self + 1);
+	segmentEnds = indices + total;
+	CONST_CAST(int*, self->indices) = indices;
+	CONST_CAST(int*, self->segmentEnds) = segmentEnds;
+	CONST_CAST(int*, self->ikIndices) = segmentEnds + ikConstraintsCount + 1;
+	memcpy(segmentEnds + ikConstraintsCount + 1, ikIndices, sizeof(int) * bonesCount);
+
+	for (i = 0, total = 0; i <= ikConstraintsCount; ++i) {
+		ii = offsets[i];
+		offsets[i] = total;
+		total += ii;
+		segmentEnds[i] = total;
+	}
+	for (i = 0; i < bonesCount; ++i) {
+		if (ikIndices[i] == -1)
+			indices[offsets[0]++] = i;
+		else {
+			indices[offsets[ikIndices[i]]++] = i;
+			indices[offsets[ikIndices[i] + 1]++] = i;
+		}
+	}
+
+	FREE(offsets);
+	FREE(ikIndices);
+	return self;
+}
+
+spUpdateOrder* spUpdateOrder_create (const spSkeletonData* data) {
+	int i, *parents, *ikParents, *ikChildren;
+	spUpdateOrder* self;
+
+	parents = MALLOC(int, data->bonesCount + data->ikConstraintsCount * 2);
+	ikParents = parents + data->bonesCount;
+	ikChildren = ikParents + data->ikConstraintsCount;
+	for (i = 0; i < data->bonesCount; ++i)
+		parents[i] = data->bones[i]->parent ? data->bones[i]->parent->index : -1;
+	for (i = 0; i < data->ikConstraintsCount; ++i) {
+		spIkConstraintData* ikConstraint = data->ikConstraints[i];
+		ikParents[i] = ikConstraint->bones[0]->index;
+		ikChildren[i] = ikConstraint->bones[ikConstraint->bonesCount - 1]->index;
+	}
+
+	self = _spUpdateOrder_create(data->bonesCount, parents, data->ikConstraintsCount, ikParents, ikChildren);
+	FREE(parents);
+	return self;
+}
+
+void spUpdateOrder_dispose (spUpdateOrder* self) {
+	FREE(self);
+}
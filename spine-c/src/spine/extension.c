@@ -77,3 +77,155 @@ char* _readFile (const char* path, int* length) {
 
 	return data;
 }
+
+/* Cody-Waite reduction of x by pi/2 in three parts, the Cephes sinf and cosf polynomials are evaluated on the remainder. */
+static float _spTrigReduce (float x, int* quadrant) {
+	int q = (int)(x * (2 / PI) + (x < 0 ? -0.5f : 0.5f));
+	*quadrant = q & 3;
+	return ((x - q * 1.5703125f) - q * 4.837512969970703125e-4f) - q * 7.549789948768648e-8f;
+}
+
+static float _spSinPoly (float r, float z) {
+	return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+}
+
+static float _spCosPoly (float z) {
+	return 1 - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+}
+
+float _spSin (float x) {
+	float sine, cosine;
+	_spSinCos(x, &sine, &cosine);
+	return sine;
+}
+
+float _spCos (float x) {
+	float sine, cosine;
+	_spSinCos(x, &sine, &cosine);
+	return cosine;
+}
+
+void _spSinCos (float x, float* sine, float* cosine) {
+	int quadrant;
+	float r = _spTrigReduce(x, &quadrant), z = r * r;
+	float s = _spSinPoly(r, z), c = _spCosPoly(z);
+	switch (quadrant) {
+	case 0:
+		*sine = s;
+		*cosine = c;
+		break;
+	case 1:
+		*sine = c;
+		*cosine = -s;
+		break;
+	case 2:
+		*sine = -s;
+		*cosine = -c;
+		break;
+	default:
+		*sine = -c;
+		*cosine = s;
+	}
+}
+
+float _spAtan2 (float y, float x) {
+	float ax = x < 0 ? -x : x, ay = y < 0 ? -y : y, t, z, r = 0;
+	if (ax == 0) return y > 0 ? PI / 2 : (y < 0 ? -PI / 2 : 0);
+	/* Cephes atanf: reduce to |t| <= tan(pi / 8). */
+	t = ay / ax;
+	if (t > 2.414213562373095f) {
+		r = PI / 2;
+		t = -1 / t;
+	} else if (t > 0.4142135623730950f) {
+		r = PI / 4;
+		t = (t - 1) / (t + 1);
+	}
+	z = t * t;
+	r += (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t;
+	if (x < 0) r = PI - r;
+	return y < 0 ? -r : r;
+}
+
+float _spAcos (float x) {
+	/* Abramowitz and Stegun 4.4.46. */
+	float ax = x < 0 ? -x : x;
+	float r = SQRT(1 - ax) * (1.5707963050f + ax * (-0.2145988016f + ax * (0.0889789874f + ax * (-0.0501743046f
+			+ ax * (0.0308918810f + ax * (-0.0170881256f + ax * (0.0066700901f + ax * -0.0012624911f)))))));
+	return x < 0 ? PI - r : r;
+}
+
+/* Arrays this small are scanned rather than indexed. */
+#define NAME_TABLE_MIN_COUNT 8
+
+typedef struct _spNameTableEntry {
+	unsigned int hash;
+	int index; /* -1 when empty. */
+} _spNameTableEntry;
+
+static const char* _spNameTable_getName (const void* items, int index, size_t nameOffset) {
+	return *(const char**)((const char*)((const void* const*)items)[index] + nameOffset);
+}
+
+static unsigned int _spNameTable_hash (const char* name) {
+	unsigned int hash = 2166136261u; /* FNV-1a */
+	for (; *name; ++name)
+		hash = (hash ^ (unsigned char)*name) * 16777619u;
+	return hash;
+}
+
+static void _spNameTable_insert (_spNameTable* self, unsigned int hash, int index) {
+	int i, mask = self->capacity - 1;
+	for (i = (int)(hash & mask); self->entries[i].index != -1; i = (i + 1) & mask) {
+	}
+	self->entries[i].hash = hash;
+	self->entries[i].index = index;
+}
+
+void _spNameTable_build (_spNameTable* self, const void* items, int count, size_t nameOffset) {
+	int i;
+	if (count <= NAME_TABLE_MIN_COUNT) {
+		self->count = 0;
+		return;
+	}
+
+	if (items != self->items || count < self->count) self->count = 0;
+	if (self->count == 0 || count * 2 > self->capacity) {
+		/* Keep the load factor at most 1/2, reinserting all items in order so duplicate names resolve to the first. */
+		int capacity = self->capacity ? self->capacity : 16;
+		while (count * 2 > capacity)
+			capacity <<= 1;
+		if (capacity != self->capacity) {
+			FREE(self->entries);
+			self->entries = MALLOC(_spNameTableEntry, capacity);
+			self->capacity = capacity;
+		}
+		for (i = 0; i < capacity; ++i)
+			self->entries[i].index = -1;
+		self->items = items;
+		self->count = 0;
+	}
+	for (; self->count < count; ++self->count)
+		_spNameTable_insert(self, _spNameTable_hash(_spNameTable_getName(items, self->count, nameOffset)), self->count);
+}
+
+int _spNameTable_find (const _spNameTable* self, const void* items, int count, size_t nameOffset, const char* name) {
+	int i, mask;
+	unsigned int hash;
+	if (count <= NAME_TABLE_MIN_COUNT || items != self->items || count != self->count) {
+		for (i = 0; i < count; ++i)
+			if (strcmp(_spNameTable_getName(items, i, nameOffset), name) == 0) return i;
+		return -1;
+	}
+
+	hash = _spNameTable_hash(name);
+	mask = self->capacity - 1;
+	for (i = (int)(hash & mask); self->entries[i].index != -1; i = (i + 1) & mask) {
+		const _spNameTableEntry* entry = self->entries + i;
+		if (entry->hash == hash && strcmp(_spNameTable_getName(items, entry->index, nameOffset), name) == 0) return entry->index;
+	}
+	return -1;
+}
+
+void _spNameTable_dispose (_spNameTable* self) {
+	FREE(self->entries);
+}
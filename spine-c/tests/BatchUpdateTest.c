@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+/* Checks that spSkeleton_updateWorldTransformBatch computes exactly the same bone transforms as
+ * spSkeleton_updateWorldTransform. Built both with SIMD and with SPINE_NO_SIMD, see the Makefile test target. */
+
+#include "TestSupport.h"
+#include <string.h>
+
+#define SKELETONS 11
+#define FRAMES 30
+
+static void pose (spSkeleton* skeleton, spSkeletonData* skeletonData, int index, int frame) {
+	spAnimation* animation = skeletonData->animations[index % skeletonData->animationsCount];
+	float time = frame * (index + 1) / 60.0f;
+	spSkeleton_setToSetupPose(skeleton);
+	spAnimation_apply(animation, skeleton, time, time, 1, 0, 0);
+	skeleton->flipX = index & 1;
+	skeleton->flipY = (index >> 1) & 1;
+	skeleton->x = index * 10.5f;
+	skeleton->y = frame * -3.25f;
+	/* Nonuniform scale on some bones exercises the scale inheritance paths. */
+	skeleton->bones[(index + frame) % skeleton->bonesCount]->scaleX = 1.5f;
+	skeleton->bones[(index * 3 + frame) % skeleton->bonesCount]->scaleY = -0.75f;
+}
+
+int main (void) {
+	spAtlas* atlas;
+	spSkeletonData* skeletonData = loadSkeletonData("data/spineboy.json", "data/spineboy.atlas", 0.6f, &atlas);
+	spSkeleton* batched[SKELETONS];
+	spSkeleton* scalar[SKELETONS];
+	int i, ii, frame, mismatches = 0;
+
+	for (i = 0; i < SKELETONS; ++i) {
+		batched[i] = spSkeleton_create(skeletonData);
+		scalar[i] = spSkeleton_create(skeletonData);
+	}
+
+	for (frame = 0; frame < FRAMES; ++frame) {
+		for (i = 0; i < SKELETONS; ++i) {
+			pose(batched[i], skeletonData, i, frame);
+			pose(scalar[i], skeletonData, i, frame);
+		}
+		/* Batches of every width, including a single skeleton which takes the scalar path. */
+		spSkeleton_updateWorldTransformBatch(batched, 4);
+		spSkeleton_updateWorldTransformBatch(batched + 4, 3);
+		spSkeleton_updateWorldTransformBatch(batched + 7, 2);
+		spSkeleton_updateWorldTransformBatch(batched + 9, 1);
+		spSkeleton_updateWorldTransformBatch(batched + 10, 1);
+		for (i = 0; i < SKELETONS; ++i) {
+			spSkeleton_updateWorldTransform(scalar[i]);
+			for (ii = 0; ii < skeletonData->bonesCount; ++ii) {
+				const spBone* a = batched[i]->bones[ii];
+				const spBone* b = scalar[i]->bones[ii];
+				/* The world fields are contiguous from m00 to worldFlipY. */
+				size_t size = (const char*)(&a->worldFlipY + 1) - (const char*)&a->m00;
+				if (memcmp(&a->m00, &b->m00, size) == 0) continue;
+				if (mismatches++ < 10) {
+					fprintf(stderr, "Frame %d, skeleton %d, bone %s: %.9g %.9g %.9g %.9g %.9g %.9g != %.9g %.9g %.9g %.9g %.9g %.9g\n",
+							frame, i, a->data->name, a->m00, a->m01, a->worldX, a->m10, a->m11, a->worldY, b->m00, b->m01, b->worldX,
+							b->m10, b->m11, b->worldY);
+				}
+			}
+		}
+	}
+	CHECK(mismatches == 0);
+
+	for (i = 0; i < SKELETONS; ++i) {
+		spSkeleton_dispose(batched[i]);
+		spSkeleton_dispose(scalar[i]);
+	}
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+	return checkFailures();
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+/* Checks that vertices skinned with the matrices from spSkeleton_writeBoneMatrices match the attachments' computeWorldVertices
+ * functions, and that spSkeleton_updateWorldTransformTo writes the same matrices as updating and then writing them. */
+
+#include "TestSupport.h"
+#include <string.h>
+
+#define STRIDE 8
+#define MAX_BONES 64
+#define MAX_VERTICES 256
+
+static float palette[MAX_BONES * STRIDE], fusedPalette[MAX_BONES * STRIDE];
+static float expected[MAX_VERTICES], actual[MAX_VERTICES];
+
+static void skinRegion (const spSkeleton* skeleton, const spSlot* slot, const spRegionAttachment* region, float* vertices) {
+	const float* m = palette + slot->data->boneData->index * STRIDE;
+	float x = skeleton->x + m[2], y = skeleton->y + m[5];
+	int i;
+	for (i = 0; i < 8; i += 2) {
+		vertices[i] = region->offset[i] * m[0] + region->offset[i + 1] * m[1] + x;
+		vertices[i + 1] = region->offset[i] * m[3] + region->offset[i + 1] * m[4] + y;
+	}
+}
+
+static void skinMesh (const spSkeleton* skeleton, const spSlot* slot, const spMeshAttachment* mesh, float* vertices) {
+	const float* m = palette + slot->data->boneData->index * STRIDE;
+	const float* local = slot->attachmentVerticesCount == mesh->verticesCount ? slot->attachmentVertices : mesh->vertices;
+	float x = skeleton->x + m[2], y = skeleton->y + m[5];
+	int i;
+	for (i = 0; i < mesh->verticesCount; i += 2) {
+		vertices[i] = local[i] * m[0] + local[i + 1] * m[1] + x;
+		vertices[i + 1] = local[i] * m[3] + local[i + 1] * m[4] + y;
+	}
+}
+
+static void skinSkinnedMesh (const spSkeleton* skeleton, const spSlot* slot, const spSkinnedMeshAttachment* mesh,
+		float* vertices) {
+	const float* ffd = slot->attachmentVerticesCount ? slot->attachmentVertices : 0;
+	int w = 0, v = 0, b = 0, f = 0;
+	while (v < mesh->bonesCount) {
+		float wx = 0, wy = 0;
+		const int nn = mesh->bones[v] + v;
+		for (v++; v <= nn; v++, b += 3, f += 2) {
+			const float* m = palette + mesh->bones[v] * STRIDE;
+			float vx = mesh->weights[b], vy = mesh->weights[b + 1];
+			if (ffd) {
+				vx += ffd[f];
+				vy += ffd[f + 1];
+			}
+			wx += (vx * m[0] + vy * m[1] + m[2]) * mesh->weights[b + 2];
+			wy += (vx * m[3] + vy * m[4] + m[5]) * mesh->weights[b + 2];
+		}
+		vertices[w++] = wx + skeleton->x;
+		vertices[w++] = wy + skeleton->y;
+	}
+}
+
+/* Counts the attachments that were checked, by type. */
+static void checkSlots (const spSkeleton* skeleton, int* checked) {
+	int i, count;
+	for (i = 0; i < skeleton->slotsCount; ++i) {
+		spSlot* slot = skeleton->slots[i];
+		spAttachment* attachment = slot->attachment;
+		if (!attachment) continue;
+		switch (attachment->type) {
+		case SP_ATTACHMENT_REGION:
+			spRegionAttachment_computeWorldVertices(((spRegionAttachment*)attachment), slot->bone, expected);
+			skinRegion(skeleton, slot, ((spRegionAttachment*)attachment), actual);
+			count = 8;
+			break;
+		case SP_ATTACHMENT_MESH:
+			spMeshAttachment_computeWorldVertices(((spMeshAttachment*)attachment), slot, expected);
+			skinMesh(skeleton, slot, ((spMeshAttachment*)attachment), actual);
+			count = ((spMeshAttachment*)attachment)->verticesCount;
+			break;
+		case SP_ATTACHMENT_SKINNED_MESH:
+			spSkinnedMeshAttachment_computeWorldVertices(((spSkinnedMeshAttachment*)attachment), slot, expected);
+			skinSkinnedMesh(skeleton, slot, ((spSkinnedMeshAttachment*)attachment), actual);
+			count = ((spSkinnedMeshAttachment*)attachment)->weightsCount / 3 * 2;
+			break;
+		default:
+			continue;
+		}
+		if (memcmp(expected, actual, sizeof(float) * count) != 0) {
+			fprintf(stderr, "Slot %s: vertices skinned with the bone matrices differ.\n", slot->data->name);
+			CHECK(0);
+		}
+		checked[attachment->type]++;
+	}
+}
+
+static void test (const char* jsonPath, int* checked) {
+	spAtlas* atlas;
+	spSkeletonData* skeletonData = loadSkeletonData(jsonPath, "data/spineboy.atlas", 0.5f, &atlas);
+	spSkeleton* skeleton = spSkeleton_create(skeletonData);
+	spSkeleton* fused = spSkeleton_create(skeletonData);
+	int i, frame;
+
+	CHECK(skeletonData->bonesCount <= MAX_BONES);
+	for (i = 0; i < skeletonData->animationsCount; ++i) {
+		spAnimation* animation = skeletonData->animations[i];
+		for (frame = 0; frame < 20; ++frame) {
+			float time = animation->duration * frame / 19;
+			spSkeleton_setToSetupPose(skeleton);
+			spSkeleton_setToSetupPose(fused);
+			spAnimation_apply(animation, skeleton, time, time, 0, 0, 0);
+			spAnimation_apply(animation, fused, time, time, 0, 0, 0);
+			skeleton->flipX = fused->flipX = frame & 1;
+			skeleton->flipY = fused->flipY = (frame >> 1) & 1;
+			skeleton->x = fused->x = frame * 7.5f;
+			skeleton->y = fused->y = -frame * 2.25f;
+
+			/* The padding between matrices must be left untouched. */
+			memset(palette, 0, sizeof(palette));
+			memset(fusedPalette, 0, sizeof(fusedPalette));
+			spSkeleton_updateWorldTransform(skeleton);
+			spSkeleton_writeBoneMatrices(skeleton, palette, STRIDE);
+			spSkeleton_updateWorldTransformTo(fused, fusedPalette, STRIDE);
+			CHECK(memcmp(palette, fusedPalette, sizeof(palette)) == 0);
+
+			checkSlots(skeleton, checked);
+		}
+	}
+
+	spSkeleton_dispose(skeleton);
+	spSkeleton_dispose(fused);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+}
+
+int main (void) {
+	int checked[SP_ATTACHMENT_SKINNED_MESH + 1] = {0};
+	test("data/spineboy.json", checked);
+	test("tests/data/mesh.json", checked);
+	/* The skeletons must exercise every attachment type that is skinned. */
+	CHECK(checked[SP_ATTACHMENT_REGION] > 0);
+	CHECK(checked[SP_ATTACHMENT_MESH] > 0);
+	CHECK(checked[SP_ATTACHMENT_SKINNED_MESH] > 0);
+	return checkFailures();
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Spine Runtimes Software License
+ * Version 2.3
+ * 
+ * Copyright (c) 2013-2015, Esoteric Software
+ * All rights reserved.
+ * 
+ * You are granted a perpetual, non-exclusive, non-sublicensable and
+ * non-transferable license to use, install, execute and perform the Spine
+ * Runtimes Software (the "Software") and derivative works solely for personal
+ * or internal use. Without the written permission of Esoteric Software (see
+ * Section 2 of the Spine Software License Agreement), you may not (a) modify,
+ * translate, adapt or otherwise create derivative works, improvements of the
+ * Software or develop new applications using the Software or (b) remove,
+ * delete, alter or obscure any trademarks or any copyright, trademark, patent
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSupport.h"
+#include <spine/extension.h>
+#include <stdlib.h>
+
+static int failures;
+
+void _spAtlasPage_createTexture (spAtlasPage* self, const char* path) {
+	self->width = 1024;
+	self->height = 1024;
+}
+
+void _spAtlasPage_disposeTexture (spAtlasPage* self) {
+}
+
+char* _spUtil_readFile (const char* path, int* length) {
+	return _readFile(path, length);
+}
+
+spSkeletonData* loadSkeletonData (const char* jsonPath, const char* atlasPath, float scale, spAtlas** atlas) {
+	spSkeletonJson* json;
+	spSkeletonData* skeletonData;
+
+	*atlas = spAtlas_createFromFile(atlasPath, 0);
+	if (!*atlas) {
+		fprintf(stderr, "Unable to load atlas: %s\n", atlasPath);
+		exit(1);
+	}
+	json = spSkeletonJson_create(*atlas);
+	json->scale = scale;
+	skeletonData = spSkeletonJson_readSkeletonDataFile(json, jsonPath);
+	if (!skeletonData) {
+		fprintf(stderr, "Unable to load skeleton: %s: %s\n", jsonPath, json->error);
+		exit(1);
+	}
+	spSkeletonJson_dispose(json);
+	return skeletonData;
+}
+
+int checkFailed (const char* condition, const char* file, int line) {
+	fprintf(stderr, "%s:%d: Check failed: %s\n", file, line, condition);
+	failures++;
+	return 0;
+}
+
+int checkFailures () {
+	return failures;
+}
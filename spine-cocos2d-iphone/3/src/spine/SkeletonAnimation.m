@@ -49,10 +49,9 @@ typedef struct _TrackEntryListeners {
 } _TrackEntryListeners;
 
 static _TrackEntryListeners* getListeners (spTrackEntry* entry) {
-	if (!entry->rendererObject) {
-		entry->rendererObject = NEW(_TrackEntryListeners);
-		entry->listener = trackEntryCallback;
-	}
+	// Entries reused from the state's pool keep their listeners.
+	if (!entry->rendererObject) entry->rendererObject = NEW(_TrackEntryListeners);
+	entry->listener = trackEntryCallback;
 	return (_TrackEntryListeners*)entry->rendererObject;
 }
 
@@ -63,11 +62,15 @@ void disposeTrackEntry (spTrackEntry* entry) {
 		[listeners->endListener release];
 		[listeners->completeListener release];
 		[listeners->eventListener release];
-		FREE(listeners);
+		memset(listeners, 0, sizeof(_TrackEntryListeners));
 	}
 	_spTrackEntry_dispose(entry);
 }
 
+void disposeTrackEntryListeners (void* rendererObject) {
+	FREE(rendererObject);
+}
+
 //
 
 @interface SkeletonAnimation (Private)
@@ -105,6 +108,7 @@ void disposeTrackEntry (spTrackEntry* entry) {
 
 	_spAnimationState* stateInternal = (_spAnimationState*)_state;
 	stateInternal->disposeTrackEntry = disposeTrackEntry;
+	stateInternal->disposeRendererObject = disposeTrackEntryListeners;
 }
 
 - (id) initWithData:(spSkeletonData*)skeletonData ownsSkeletonData:(bool)ownsSkeletonData {
@@ -57,18 +57,27 @@ typedef struct _TrackEntryListeners {
 } _TrackEntryListeners;
 
 static _TrackEntryListeners* getListeners (spTrackEntry* entry) {
-	if (!entry->rendererObject) {
-		entry->rendererObject = NEW(spine::_TrackEntryListeners);
-		entry->listener = trackEntryCallback;
-	}
+	// Entries reused from the state's pool keep their listeners.
+	if (!entry->rendererObject) entry->rendererObject = NEW(spine::_TrackEntryListeners);
+	entry->listener = trackEntryCallback;
 	return (_TrackEntryListeners*)entry->rendererObject;
 }
 
 void disposeTrackEntry (spTrackEntry* entry) {
-	if (entry->rendererObject) FREE(entry->rendererObject);
+	if (entry->rendererObject) {
+		_TrackEntryListeners* listeners = (_TrackEntryListeners*)entry->rendererObject;
+		listeners->startListener = nullptr;
+		listeners->endListener = nullptr;
+		listeners->completeListener = nullptr;
+		listeners->eventListener = nullptr;
+	}
 	_spTrackEntry_dispose(entry);
 }
 
+void disposeTrackEntryListeners (void* rendererObject) {
+	FREE(rendererObject);
+}
+
 //
 
 SkeletonAnimation* SkeletonAnimation::createWithData (spSkeletonData* skeletonData, bool ownsSkeletonData) {
@@ -97,6 +106,7 @@ void SkeletonAnimation::initialize () {
 
 	_spAnimationState* stateInternal = (_spAnimationState*)_state;
 	stateInternal->disposeTrackEntry = disposeTrackEntry;
+	stateInternal->disposeRendererObject = disposeTrackEntryListeners;
 }
 
 SkeletonAnimation::SkeletonAnimation ()